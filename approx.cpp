@@ -0,0 +1,401 @@
+/*
+ *      approx.cpp
+ *      Justin Paik (jpaik03)
+ *      11 December, 2025
+ *      Divide & Conquer Convex Hull Algorithm
+ *
+ *      Contains function definitions for the epsilon-approximate convex hull.
+ *      Points are bucketed into vertical strips and only the lowest and
+ *      highest point of each strip is kept, so the hull is built from at most
+ *      two points per strip instead of from every sorted point.
+ */
+
+/* Standard c++ Includes */
+#include <iostream>
+#include <algorithm>
+#include <thread>
+#include <cmath>
+#include <climits>
+#include "assert.h"
+
+#include "approx.h"
+#include "parallel.h"
+
+using namespace std;
+
+/* Define constants */
+const size_t MIN_CHUNK = 1 << 16;       /* Fewest points per thread chunk */
+
+/* Helper function declarations */
+static void findXRange(const Points &pts, int &minX, int &maxX);
+static Points stripExtremes(const Points &pts, int minX, int maxX,
+                            int strips);
+static Points chainHull(Points &cand);
+static double measureError(const Points &pts, const Points &hull);
+static double distToHull(const my_point &p, const Points &hull, int start);
+static double segmentDist(const my_point &p, const my_point &a,
+                          const my_point &b);
+
+/******** approxHull ********
+ *
+ * Builds a convex polygon whose distance to the true convex hull is at most
+ * a given bound.
+ *
+ * Parameters:
+ *      const Points &pts:      The set of points.
+ *      double eps:             The largest error allowed, in coordinate
+ *                              units.
+ *      ApproxStats *stats:     Filled with the strip count, the bound, and
+ *                              the measured error. May be nullptr, which
+ *                              also skips measuring the error.
+ * Returns:
+ *      A Points object containing the polygon in the same CCW order as dnc.
+ *      Every vertex is one of the input points.
+ * Expects:
+ *      pts is not empty and eps > 0.
+ * Notes:
+ *      Throws a CRE if pts is empty or eps is not positive.
+ *      Runs in O(n) plus O(k log k) for k strips, on several threads. The
+ *        input is not sorted or modified.
+ *      Every point lies in a strip whose lowest and highest points are kept,
+ *        so it is within one strip width of the polygon.
+ *      If eps would need at least one strip per point, the exact hull is
+ *        built from all the points instead, so the bound always holds.
+ ************************/
+Points approxHull(const Points &pts, double eps, ApproxStats *stats)
+{
+        if (pts.empty()) {
+                cerr << "No points given.\n";
+                exit(EXIT_FAILURE);
+        }
+        if (!(eps > 0)) {
+                cerr << "Error bound must be positive.\n";
+                exit(EXIT_FAILURE);
+        }
+
+        int minX, maxX;
+        findXRange(pts, minX, maxX);
+
+        /* Pick enough strips that each is at most eps wide */
+        long long width = (long long) maxX - minX + 1;
+        long long strips = (long long) ceil(width / eps);
+        strips = max(1LL, min(strips, width));
+
+        /* As many strips as points saves nothing: build the exact hull */
+        Points hull;
+        double bound;
+        if (strips >= (long long) pts.size()) {
+                Points cand = pts;
+                hull = chainHull(cand);
+                strips = 0;
+                bound = 0;
+        } else {
+                Points cand = stripExtremes(pts, minX, maxX, strips);
+                hull = chainHull(cand);
+
+                /* One x per strip keeps every column's ends: exact */
+                bound = (strips == width) ? 0 : (double) width / strips;
+        }
+
+        if (stats != nullptr) {
+                stats->strips = strips;
+                stats->bound = bound;
+                stats->error = measureError(pts, hull);
+        }
+        return hull;
+}
+
+/******** findXRange ********
+ *
+ * Finds the smallest and largest x-coordinate of a set of points.
+ *
+ * Parameters:
+ *      const Points &pts:      The set of points.
+ *      int &minX, &maxX:       Set to the smallest and largest x.
+ * Returns:
+ *      None.
+ * Expects:
+ *      pts is not empty.
+ * Notes:
+ *      Each thread reduces its own chunk with a branch-free loop.
+ ************************/
+static void findXRange(const Points &pts, int &minX, int &maxX)
+{
+        size_t n = pts.size();
+        int chunks = min<size_t>(n / MIN_CHUNK + 1,
+                                 4 * max(1u, thread::hardware_concurrency()));
+        vector<int> lo(chunks, INT_MAX), hi(chunks, INT_MIN);
+
+        parallelFor(chunks, [&](int c) {
+                size_t first = n * c / chunks, last = n * (c + 1) / chunks;
+                int l = INT_MAX, h = INT_MIN;
+                for (size_t i = first; i < last; i++) {
+                        l = min(l, pts[i].x);
+                        h = max(h, pts[i].x);
+                }
+                lo[c] = l;
+                hi[c] = h;
+        });
+
+        minX = *min_element(lo.begin(), lo.end());
+        maxX = *max_element(hi.begin(), hi.end());
+}
+
+/******** stripExtremes ********
+ *
+ * Finds the lowest and highest point of every vertical strip.
+ *
+ * Parameters:
+ *      const Points &pts:      The set of points.
+ *      int minX, maxX:         The x range of pts.
+ *      int strips:             The number of equal-width strips.
+ * Returns:
+ *      The candidate hull points: up to two per strip, plus the lowest and
+ *      highest points on the leftmost and rightmost x.
+ * Expects:
+ *      1 <= strips <= maxX - minX + 1.
+ * Notes:
+ *      Each chunk of points fills its own per-strip table, and the tables
+ *        are then combined strip by strip.
+ ************************/
+static Points stripExtremes(const Points &pts, int minX, int maxX,
+                            int strips)
+{
+        size_t n = pts.size();
+        long long width = (long long) maxX - minX + 1;
+        int chunks = min<size_t>(n / MIN_CHUNK + 1,
+                                 4 * max(1u, thread::hardware_concurrency()));
+
+        /* Slots [0, strips) hold strips; the last two hold x == minX/maxX */
+        int slots = strips + 2;
+        vector<int> lowIdx((size_t) chunks * slots, -1);
+        vector<int> highIdx((size_t) chunks * slots, -1);
+
+        parallelFor(chunks, [&](int c) {
+                size_t first = n * c / chunks, last = n * (c + 1) / chunks;
+                int *low = &lowIdx[(size_t) c * slots];
+                int *high = &highIdx[(size_t) c * slots];
+                for (size_t i = first; i < last; i++) {
+                        const my_point &p = pts[i];
+                        int s = (p.x - (long long) minX) * strips / width;
+                        int e = (p.x == minX) ? strips :
+                                (p.x == maxX) ? strips + 1 : -1;
+                        for (int slot : {s, e}) {
+                                if (slot < 0) continue;
+                                if (low[slot] < 0 || p.y < pts[low[slot]].y) {
+                                        low[slot] = i;
+                                }
+                                if (high[slot] < 0 ||
+                                    p.y > pts[high[slot]].y) {
+                                        high[slot] = i;
+                                }
+                        }
+                }
+        });
+
+        /* Combine the chunks' tables into chunk 0 */
+        parallelFor(slots, [&](int s) {
+                for (int c = 1; c < chunks; c++) {
+                        int l = lowIdx[(size_t) c * slots + s];
+                        int h = highIdx[(size_t) c * slots + s];
+                        if (l >= 0 && (lowIdx[s] < 0 ||
+                                       pts[l].y < pts[lowIdx[s]].y)) {
+                                lowIdx[s] = l;
+                        }
+                        if (h >= 0 && (highIdx[s] < 0 ||
+                                       pts[h].y > pts[highIdx[s]].y)) {
+                                highIdx[s] = h;
+                        }
+                }
+        });
+
+        Points cand;
+        for (int s = 0; s < slots; s++) {
+                if (lowIdx[s] < 0) continue;
+                cand.push_back(pts[lowIdx[s]]);
+                if (highIdx[s] != lowIdx[s]) {
+                        cand.push_back(pts[highIdx[s]]);
+                }
+        }
+        return cand;
+}
+
+/******** chainHull ********
+ *
+ * Builds the convex hull of a small set of candidate points.
+ *
+ * Parameters:
+ *      Points &cand:   The candidate points. Sorted in place.
+ * Returns:
+ *      A Points object containing the hull in CCW order, without collinear
+ *      points.
+ * Expects:
+ *      cand is not empty.
+ * Notes:
+ *      Sorts only the candidates, then builds the lower and upper chains.
+ ************************/
+static Points chainHull(Points &cand)
+{
+        assert(!cand.empty());
+
+        sortPoints(cand);
+        cand.erase(unique(cand.begin(), cand.end(),
+                          [](const my_point &a, const my_point &b) {
+                                  return a.x == b.x && a.y == b.y;
+                          }),
+                   cand.end());
+        if (cand.size() <= 2) return cand;
+
+        Points hull;
+        int n = cand.size();
+
+        /* Lower chain left to right, then upper chain right to left */
+        for (int pass = 0; pass < 2; pass++) {
+                size_t base = hull.size();
+                for (int k = 0; k < n; k++) {
+                        const my_point &p = cand[pass == 0 ? k : n - 1 - k];
+                        while (hull.size() >= base + 2 &&
+                               crossProduct(hull[hull.size() - 2],
+                                            hull.back(), p) <= 0) {
+                                hull.pop_back();
+                        }
+                        hull.push_back(p);
+                }
+                /* The last point starts the next chain */
+                hull.pop_back();
+        }
+        return hull;
+}
+
+/******** measureError ********
+ *
+ * Measures how far the farthest input point lies outside a hull.
+ *
+ * Parameters:
+ *      const Points &pts:      The set of points.
+ *      const Points &hull:     A convex polygon built from pts.
+ * Returns:
+ *      The Hausdorff distance between the hull and the true convex hull.
+ * Expects:
+ *      hull is in CCW order and its vertices are points of pts.
+ * Notes:
+ *      Since hull lies inside the true hull, the distance is the largest
+ *        distance from any input point to hull. Each point starts its search
+ *        at the edge above or below its x-coordinate.
+ ************************/
+static double measureError(const Points &pts, const Points &hull)
+{
+        if (hull.size() < 3) {
+                /* A point or segment: check every point against it */
+                double worst = 0;
+                for (size_t i = 0; i < pts.size(); i++) {
+                        worst = max(worst, segmentDist(pts[i], hull[0],
+                                                       hull.back()));
+                }
+                return worst;
+        }
+
+        /* hull[0] is the leftmost vertex and hull[right] the rightmost */
+        int h = hull.size();
+        int right = 0;
+        for (int k = 1; k < h; k++) {
+                if (hull[k].x > hull[right].x) right = k;
+        }
+
+        size_t n = pts.size();
+        int chunks = min<size_t>(n / MIN_CHUNK + 1,
+                                 4 * max(1u, thread::hardware_concurrency()));
+        vector<double> worst(chunks, 0);
+
+        parallelFor(chunks, [&](int c) {
+                size_t first = n * c / chunks, last = n * (c + 1) / chunks;
+                for (size_t i = first; i < last; i++) {
+                        const my_point &p = pts[i];
+
+                        /* Lower chain is hull[0..right], upper is the rest */
+                        int lo, hi;
+                        if (crossProduct(hull[0], hull[right], p) < 0) {
+                                lo = 0;
+                                hi = right;
+                        } else {
+                                lo = right;
+                                hi = h;
+                        }
+                        /* Binary search for the edge spanning p.x */
+                        bool lower = (lo == 0);
+                        while (hi - lo > 1) {
+                                int mid = (lo + hi) / 2;
+                                if ((hull[mid].x <= p.x) == lower) {
+                                        lo = mid;
+                                } else {
+                                        hi = mid;
+                                }
+                        }
+
+                        const my_point &a = hull[lo];
+                        const my_point &b = hull[(lo + 1) % h];
+                        if (crossProduct(a, b, p) >= 0) continue;
+                        worst[c] = max(worst[c], distToHull(p, hull, lo));
+                }
+        });
+
+        return *max_element(worst.begin(), worst.end());
+}
+
+/******** distToHull ********
+ *
+ * Finds the distance from a point outside a convex polygon to the polygon.
+ *
+ * Parameters:
+ *      const my_point &p:      A point outside the polygon.
+ *      const Points &hull:     The polygon, in CCW order.
+ *      int start:              An edge that p lies outside of.
+ * Returns:
+ *      The distance from p to the nearest edge.
+ * Expects:
+ *      p is outside edge start of hull.
+ * Notes:
+ *      The distance to the edges falls and then rises along the polygon, so
+ *        the search walks both ways from start while it keeps falling.
+ ************************/
+static double distToHull(const my_point &p, const Points &hull, int start)
+{
+        int h = hull.size();
+        double best = segmentDist(p, hull[start], hull[(start + 1) % h]);
+
+        for (int dir = -1; dir <= 1; dir += 2) {
+                int k = start;
+                for (int steps = 1; steps < h; steps++) {
+                        k = (k + dir + h) % h;
+                        double d = segmentDist(p, hull[k], hull[(k + 1) % h]);
+                        if (d > best) break;
+                        best = d;
+                }
+        }
+        return best;
+}
+
+/******** segmentDist ********
+ *
+ * Finds the distance from a point to a line segment.
+ *
+ * Parameters:
+ *      const my_point &p:      The point.
+ *      const my_point &a, &b:  The ends of the segment.
+ * Returns:
+ *      The Euclidean distance from p to the nearest point of segment ab.
+ * Expects:
+ *      None.
+ * Notes:
+ *      Handles a == b.
+ ************************/
+static double segmentDist(const my_point &p, const my_point &a,
+                          const my_point &b)
+{
+        double dx = b.x - a.x, dy = b.y - a.y;
+        double px = p.x - a.x, py = p.y - a.y;
+        double len = dx * dx + dy * dy;
+        double t = (len > 0) ? (px * dx + py * dy) / len : 0;
+        t = max(0.0, min(1.0, t));
+        return hypot(px - t * dx, py - t * dy);
+}
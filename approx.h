@@ -0,0 +1,28 @@
+/*
+ *      approx.h
+ *      Justin Paik (jpaik03)
+ *      11 December, 2025
+ *      Divide & Conquer Convex Hull Algorithm
+ *
+ *      Contains function declarations for the epsilon-approximate convex
+ *      hull, built in linear time without sorting.
+ */
+
+#ifndef APPROX_H
+#define APPROX_H
+
+#include "dnc.h"
+
+using namespace std;
+
+/* What approxHull achieved */
+struct ApproxStats {
+        int strips;             /* Vertical strips used, 0 if exact */
+        double bound;           /* Guaranteed error (the strip width) */
+        double error;           /* Measured Hausdorff distance to the hull */
+};
+
+/* Function Declarations */
+Points approxHull(const Points &pts, double eps, ApproxStats *stats);
+
+#endif
@@ -0,0 +1,787 @@
+/*
+ *      bench.cpp
+ *      Justin Paik (jpaik03)
+ *      11 December, 2025
+ *      Divide & Conquer Convex Hull Algorithm
+ *
+ *      The benchmark driver for dnc_ch. Generates random point sets and times
+ *      the solvers on them with the visualization turned off.
+ */
+
+/* Standard c++ Includes */
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cstdio>
+#include <cmath>
+#include <fstream>
+#include <numeric>
+#include <functional>
+#include <fcntl.h>
+#include <unistd.h>
+#include "assert.h"
+
+#include "dnc.h"
+#include "layers.h"
+#include "pyramid.h"
+#include "approx.h"
+#include "output.h"
+#include "packed.h"
+
+using namespace std;
+
+typedef chrono::steady_clock benchClock;
+
+/* Function declarations */
+static Points randomPoints(int n, int range, unsigned seed);
+static Points distinctPoints(int n, int range, unsigned seed);
+static Points referenceHull(Points pts, bool keepCollinear);
+static bool isHullOf(const Points &hull, const Points &pts);
+static double secondsSince(benchClock::time_point start);
+static vector<int> naiveLayers(const Points &pts);
+static void benchLayers(int n);
+static bool sameHull(Points a, Points b);
+static void benchPyramid(int n);
+static void benchApprox(int n);
+static Points circlePoints(int n, int radius);
+static void benchOutput(int n);
+static double timeRepeated(const function<size_t()> &write, size_t &bytes);
+static void benchPacked(int n);
+static void benchMerge(int n);
+
+/* Define constants */
+const int RANGE = 30000;        /* Coordinates are in [0, RANGE) */
+const unsigned SEED = 163;
+const int TILES = 64;           /* Pyramid grid is TILES x TILES */
+const int QUERIES = 200;
+const double MIN_TIME = 0.2;    /* Seconds a throughput figure runs for */
+
+int main(int argc, char *argv[])
+{
+        if (argc < 2 || argc > 3) {
+                cerr << "Usage: ./bench_ch "
+                     << "layers|pyramid|approx|output|packed|merge "
+                     << "[numPoints]\n";
+                exit(EXIT_FAILURE);
+        }
+
+        string mode = argv[1];
+        int n = (argc == 3) ? stoi(argv[2]) : 10000;
+
+        /* merge keeps the default setting, as a library caller would */
+        if (mode != "merge") setVisualization(false);
+
+        if (mode == "layers") {
+                benchLayers(n);
+        } else if (mode == "pyramid") {
+                benchPyramid(n);
+        } else if (mode == "approx") {
+                benchApprox(n);
+        } else if (mode == "output") {
+                benchOutput(n);
+        } else if (mode == "packed") {
+                benchPacked(n);
+        } else if (mode == "merge") {
+                benchMerge(n);
+        } else {
+                cerr << "Unknown benchmark: " << mode << "\n";
+                exit(EXIT_FAILURE);
+        }
+
+        return 0;
+}
+
+/******** randomPoints ********
+ *
+ * Generates uniformly random points with IDs 0 to n - 1.
+ *
+ * Parameters:
+ *      int n:          The number of points.
+ *      int range:      Coordinates are drawn from [0, range).
+ *      unsigned seed:  Seed for the generator, so runs are repeatable.
+ * Returns:
+ *      A Points object of size n.
+ * Expects:
+ *      n > 0 and range > 0.
+ * Notes:
+ *      Points may repeat; keep n well below range * range.
+ ************************/
+static Points randomPoints(int n, int range, unsigned seed)
+{
+        assert(n > 0 && range > 0);
+
+        mt19937 gen(seed);
+        uniform_int_distribution<int> coord(0, range - 1);
+
+        Points pts(n);
+        for (int i = 0; i < n; i++) {
+                pts[i].x = coord(gen);
+                pts[i].y = coord(gen);
+                pts[i].ID = i;
+        }
+        return pts;
+}
+
+/******** distinctPoints ********
+ *
+ * Generates random points in which no two share an x- or a y-coordinate.
+ *
+ * Parameters:
+ *      int n:          The number of points.
+ *      int range:      Coordinates are drawn from [0, range).
+ *      unsigned seed:  Seed for the generator, so runs are repeatable.
+ * Returns:
+ *      A Points object of size n with IDs 0 to n - 1.
+ * Expects:
+ *      0 < n <= range.
+ * Notes:
+ *      dnc needs distinct x-coordinates to be exact, so results built with
+ *        it can be checked against referenceHull on these points.
+ ************************/
+static Points distinctPoints(int n, int range, unsigned seed)
+{
+        assert(n > 0 && n <= range);
+
+        mt19937 gen(seed);
+        vector<int> xs(range), ys(range);
+        for (int i = 0; i < range; i++) {
+                xs[i] = ys[i] = i;
+        }
+        shuffle(xs.begin(), xs.end(), gen);
+        shuffle(ys.begin(), ys.end(), gen);
+
+        Points pts(n);
+        for (int i = 0; i < n; i++) {
+                pts[i].x = xs[i];
+                pts[i].y = ys[i];
+                pts[i].ID = i;
+        }
+        return pts;
+}
+
+/******** referenceHull ********
+ *
+ * Builds a convex hull with a plain monotone chain, to check other solvers.
+ *
+ * Parameters:
+ *      Points pts:             The set of points (copied, then sorted).
+ *      bool keepCollinear:     True to keep points lying on a hull edge.
+ * Returns:
+ *      The hull in CCW order.
+ * Expects:
+ *      No two points are equal if keepCollinear is true.
+ * Notes:
+ *      Handles collinear points, unlike dnc.
+ ************************/
+static Points referenceHull(Points pts, bool keepCollinear)
+{
+        sortPoints(pts);
+        if (pts.size() <= 2) return pts;
+
+        Points hull;
+        int n = pts.size();
+
+        /* Lower chain left to right, then upper chain right to left */
+        for (int pass = 0; pass < 2; pass++) {
+                size_t base = hull.size();
+                for (int k = 0; k < n; k++) {
+                        const my_point &p = pts[pass == 0 ? k : n - 1 - k];
+                        while (hull.size() >= base + 2) {
+                                int turn = crossProduct(hull[hull.size() - 2],
+                                                        hull.back(), p);
+                                if (turn > 0 || (turn == 0 && keepCollinear)) {
+                                        break;
+                                }
+                                hull.pop_back();
+                        }
+                        hull.push_back(p);
+                }
+                /* The last point starts the next chain */
+                hull.pop_back();
+        }
+        return hull;
+}
+
+/******** isHullOf ********
+ *
+ * Checks a solver's hull against the reference hull of the same points.
+ *
+ * Parameters:
+ *      const Points &hull:     The hull to check.
+ *      const Points &pts:      The points it was built from.
+ * Returns:
+ *      True if hull holds every corner of the true hull and nothing that is
+ *      off its boundary.
+ * Expects:
+ *      No two points of pts are equal.
+ * Notes:
+ *      A point in the middle of a hull edge may be kept or dropped, since
+ *        dnc keeps some of them.
+ ************************/
+static bool isHullOf(const Points &hull, const Points &pts)
+{
+        vector<int> ids, corners, boundary;
+        for (const my_point &p : hull) ids.push_back(p.ID);
+        for (const my_point &p : referenceHull(pts, false)) {
+                corners.push_back(p.ID);
+        }
+        for (const my_point &p : referenceHull(pts, true)) {
+                boundary.push_back(p.ID);
+        }
+        sort(ids.begin(), ids.end());
+        sort(corners.begin(), corners.end());
+        sort(boundary.begin(), boundary.end());
+
+        return adjacent_find(ids.begin(), ids.end()) == ids.end() &&
+               includes(ids.begin(), ids.end(), corners.begin(),
+                        corners.end()) &&
+               includes(boundary.begin(), boundary.end(), ids.begin(),
+                        ids.end());
+}
+
+/******** secondsSince ********
+ *
+ * Returns the time elapsed since a given time point.
+ *
+ * Parameters:
+ *      benchClock::time_point start:   The time point to measure from.
+ * Returns:
+ *      The elapsed time in seconds.
+ * Expects:
+ *      None.
+ * Notes:
+ *      None.
+ ************************/
+static double secondsSince(benchClock::time_point start)
+{
+        return chrono::duration<double>(benchClock::now() - start).count();
+}
+
+/******** naiveLayers ********
+ *
+ * Computes convex layers by calling dnc again after removing each hull.
+ *
+ * Parameters:
+ *      const Points &pts:      The set of points to peel.
+ * Returns:
+ *      A vector indexed by my_point.ID holding the layer of each point.
+ * Expects:
+ *      Every ID is in [0, pts.size()).
+ * Notes:
+ *      This is the O(n log n) per layer baseline that convexLayers replaces.
+ ************************/
+static vector<int> naiveLayers(const Points &pts)
+{
+        vector<int> layer(pts.size(), -1);
+        Points rest = pts;
+
+        for (int depth = 0; !rest.empty(); depth++) {
+                Points work = rest;
+                Points hull = dnc(work);
+                for (size_t i = 0; i < hull.size(); i++) {
+                        layer[hull[i].ID] = depth;
+                }
+
+                size_t kept = 0;
+                for (size_t i = 0; i < rest.size(); i++) {
+                        if (layer[rest[i].ID] == -1) {
+                                rest[kept++] = rest[i];
+                        }
+                }
+                rest.resize(kept);
+        }
+
+        return layer;
+}
+
+/******** benchLayers ********
+ *
+ * Times convexLayers against the repeated dnc loop and prints the results.
+ *
+ * Parameters:
+ *      int n:  The number of random points.
+ * Returns:
+ *      None.
+ * Expects:
+ *      n > 0.
+ * Notes:
+ *      dnc does not handle collinear points, so the two layer counts can
+ *        differ slightly on random input.
+ ************************/
+static void benchLayers(int n)
+{
+        Points pts = randomPoints(n, RANGE, SEED);
+
+        Points work = pts;
+        benchClock::time_point start = benchClock::now();
+        vector<int> fast = convexLayers(work);
+        double fastTime = secondsSince(start);
+
+        start = benchClock::now();
+        vector<int> slow = naiveLayers(pts);
+        double slowTime = secondsSince(start);
+
+        int fastDepth = 0, slowDepth = 0;
+        for (int i = 0; i < n; i++) {
+                fastDepth = max(fastDepth, fast[i] + 1);
+                slowDepth = max(slowDepth, slow[i] + 1);
+        }
+
+        cout << n << " points\n";
+        cout << "convexLayers:  " << fastDepth << " layers in "
+             << fastTime << " s\n";
+        cout << "repeated dnc:  " << slowDepth << " layers in "
+             << slowTime << " s\n";
+        cout << "speedup:       " << slowTime / fastTime << "x\n";
+}
+
+/******** sameHull ********
+ *
+ * Checks whether two hulls contain the same points.
+ *
+ * Parameters:
+ *      Points a, b:    The hulls to compare.
+ * Returns:
+ *      True if a and b hold the same set of IDs.
+ * Expects:
+ *      None.
+ * Notes:
+ *      Ignores the starting point, since merges may rotate the hull.
+ ************************/
+static bool sameHull(Points a, Points b)
+{
+        if (a.size() != b.size()) return false;
+
+        vector<int> idsA, idsB;
+        for (size_t i = 0; i < a.size(); i++) {
+                idsA.push_back(a[i].ID);
+                idsB.push_back(b[i].ID);
+        }
+        sort(idsA.begin(), idsA.end());
+        sort(idsB.begin(), idsB.end());
+        return idsA == idsB;
+}
+
+/******** benchPyramid ********
+ *
+ * Times random tile range queries on a hull pyramid against running dnc on
+ * the raw points of each range, then saves and maps the pyramid back.
+ *
+ * Parameters:
+ *      int n:  The number of random points.
+ * Returns:
+ *      None.
+ * Expects:
+ *      0 < n <= RANGE.
+ * Notes:
+ *      Throws an error if n is too large or if any query answer is not the
+ *        hull of the points in its range (checked with isHullOf).
+ *      Uses points with distinct x- and y-coordinates, since the pyramid is
+ *        built with dnc.
+ *      Writes a temporary file named bench_pyramid.bin in the working
+ *        directory and removes it afterwards.
+ ************************/
+static void benchPyramid(int n)
+{
+        if (n > RANGE) {
+                cerr << "pyramid needs numPoints <= " << RANGE << ".\n";
+                exit(EXIT_FAILURE);
+        }
+        Points pts = distinctPoints(n, RANGE, SEED);
+        int tile = (RANGE + TILES - 1) / TILES;
+
+        benchClock::time_point start = benchClock::now();
+        HullPyramid pyr = buildPyramid(pts, 0, 0, tile, tile, TILES, TILES);
+        double buildTime = secondsSince(start);
+
+        /* Random tile ranges */
+        mt19937 gen(SEED);
+        uniform_int_distribution<int> pick(0, TILES - 1);
+        vector<int> ranges;
+        for (int q = 0; q < QUERIES; q++) {
+                int a = pick(gen), b = pick(gen), c = pick(gen), d = pick(gen);
+                ranges.insert(ranges.end(), {min(a, b), min(c, d),
+                                             max(a, b), max(c, d)});
+        }
+
+        vector<Points> answers(QUERIES);
+        start = benchClock::now();
+        for (int q = 0; q < QUERIES; q++) {
+                const int *rg = &ranges[4 * q];
+                answers[q] = queryPyramid(pyr, rg[0], rg[1], rg[2], rg[3]);
+        }
+        double queryTime = secondsSince(start);
+
+        /* Time dnc on each range, and check the answer against it */
+        int mismatches = 0;
+        double dncTime = 0;
+        for (int q = 0; q < QUERIES; q++) {
+                const int *rg = &ranges[4 * q];
+                Points inside;
+                for (size_t i = 0; i < pts.size(); i++) {
+                        int c = pts[i].x / tile, r = pts[i].y / tile;
+                        if (c >= rg[0] && c <= rg[2] &&
+                            r >= rg[1] && r <= rg[3]) {
+                                inside.push_back(pts[i]);
+                        }
+                }
+                if (!isHullOf(answers[q], inside)) mismatches++;
+
+                start = benchClock::now();
+                if (!inside.empty()) dnc(inside);
+                dncTime += secondsSince(start);
+        }
+
+        const string file = "bench_pyramid.bin";
+        start = benchClock::now();
+        savePyramid(pyr, file);
+        double saveTime = secondsSince(start);
+
+        start = benchClock::now();
+        HullPyramid mapped = loadPyramid(file);
+        double loadTime = secondsSince(start);
+        for (int q = 0; q < QUERIES; q++) {
+                const int *rg = &ranges[4 * q];
+                Points hull = queryPyramid(mapped, rg[0], rg[1], rg[2], rg[3]);
+                if (!sameHull(hull, answers[q])) mismatches++;
+        }
+        freePyramid(mapped);
+        freePyramid(pyr);
+        remove(file.c_str());
+
+        cout << n << " points, " << TILES << "x" << TILES << " tiles, "
+             << QUERIES << " queries\n";
+        cout << "build:         " << buildTime << " s\n";
+        cout << "pyramid query: " << queryTime << " s\n";
+        cout << "dnc on range:  " << dncTime << " s\n";
+        cout << "save / map:    " << saveTime << " s / " << loadTime
+             << " s\n";
+        cout << "differ:        " << mismatches << "\n";
+        if (mismatches > 0) {
+                cerr << "Pyramid answers differ from the reference hull.\n";
+                exit(EXIT_FAILURE);
+        }
+}
+
+/******** benchApprox ********
+ *
+ * Times approxHull at several error bounds against dnc and prints the error
+ * each one achieved.
+ *
+ * Parameters:
+ *      int n:  The number of random points.
+ * Returns:
+ *      None.
+ * Expects:
+ *      n > 0.
+ * Notes:
+ *      The approximate times include measuring the error, which costs about
+ *        as much as building the hull.
+ ************************/
+static void benchApprox(int n)
+{
+        Points pts = randomPoints(n, RANGE, SEED);
+
+        Points work = pts;
+        benchClock::time_point start = benchClock::now();
+        Points exact = dnc(work);
+        double dncTime = secondsSince(start);
+
+        cout << n << " points\n";
+        cout << "dnc:           " << exact.size() << " points in "
+             << dncTime << " s\n";
+
+        const double epsilons[] = {1, 10, 100, 1000};
+        for (double eps : epsilons) {
+                ApproxStats stats;
+                start = benchClock::now();
+                Points hull = approxHull(pts, eps, &stats);
+                double approxTime = secondsSince(start);
+
+                cout << "eps " << eps << ":\t" << hull.size()
+                     << " points in " << approxTime << " s, "
+                     << stats.strips << " strips, bound " << stats.bound
+                     << ", error " << stats.error << "\n";
+        }
+}
+
+/******** circlePoints ********
+ *
+ * Generates points on a circle, so most of them are on the hull.
+ *
+ * Parameters:
+ *      int n:          The number of points.
+ *      int radius:     The radius of the circle, centered at the origin.
+ * Returns:
+ *      A Points object of size n with IDs 0 to n - 1, in random order.
+ * Expects:
+ *      n > 0.
+ * Notes:
+ *      Rounding to integers pushes some points just inside the hull and can
+ *        repeat points when n is large compared to the radius.
+ ************************/
+static Points circlePoints(int n, int radius)
+{
+        Points pts(n);
+        for (int i = 0; i < n; i++) {
+                double angle = 2 * M_PI * i / n;
+                pts[i].x = lround(radius * cos(angle));
+                pts[i].y = lround(radius * sin(angle));
+        }
+        shuffle(pts.begin(), pts.end(), mt19937(SEED));
+        for (int i = 0; i < n; i++) {
+                pts[i].ID = i;
+        }
+        return pts;
+}
+
+/******** benchOutput ********
+ *
+ * Times dnc against dncIndices on a large hull, then times writing with
+ * operator<< (as printPoints does) against the buffered writer.
+ *
+ * Parameters:
+ *      int n:  The number of points on the circle.
+ * Returns:
+ *      None.
+ * Expects:
+ *      n > 0.
+ * Notes:
+ *      Writes to /dev/null, so only formatting and system call costs count.
+ *      Points on an integer circle are rarely all on the hull, so the hull
+ *        is reported end to end only: one write, with its fixed costs.
+ *        Throughput is measured by writing all n sorted points as if they
+ *        were the hull, repeated for at least MIN_TIME seconds.
+ ************************/
+static void benchOutput(int n)
+{
+        Points pts = circlePoints(n, RANGE / 2);
+
+        Points work = pts;
+        benchClock::time_point start = benchClock::now();
+        Points hull = dnc(work);
+        double dncTime = secondsSince(start);
+
+        work = pts;
+        vector<int> buf;
+        start = benchClock::now();
+        IndexSpan span = dncIndices(work, buf, SORTED_INDEX);
+        double indexTime = secondsSince(start);
+
+        cout << n << " points, " << hull.size() << " on the hull\n";
+        cout << "dnc:           " << dncTime << " s\n";
+        cout << "dncIndices:    " << indexTime << " s\n";
+
+        ofstream sink("/dev/null");
+        int fd = open("/dev/null", O_WRONLY);
+        const char *names[] = {"text", "binary", "ids"};
+
+        cout << "end to end, the hull:\n";
+        start = benchClock::now();
+        for (size_t i = 0; i < hull.size(); i++) {
+                sink << "(" << hull[i].x << ", " << hull[i].y << ")\n";
+        }
+        sink.flush();
+        cout << "  operator<<:  " << secondsSince(start) << " s\n";
+        for (const char *name : names) {
+                OutputFormat format;
+                parseFormat(name, format);
+                start = benchClock::now();
+                size_t bytes = writeHull(work, span, format, fd);
+                double secs = secondsSince(start);
+                cout << "  writer " << name << ":\t" << bytes << " bytes in "
+                     << secs << " s\n";
+        }
+
+        /* Every sorted point, as one large hull */
+        vector<int> every(work.size());
+        iota(every.begin(), every.end(), 0);
+        IndexSpan all = {every.data(), every.size()};
+        size_t bytes;
+
+        cout << "throughput, all " << n << " points:\n";
+        double secs = timeRepeated([&]() -> size_t {
+                for (size_t i = 0; i < work.size(); i++) {
+                        sink << "(" << work[i].x << ", " << work[i].y
+                             << ")\n";
+                }
+                sink.flush();
+                return 0;
+        }, bytes);
+        cout << "  operator<<:  " << n / secs / 1e6 << " Mpoints/s\n";
+        for (const char *name : names) {
+                OutputFormat format;
+                parseFormat(name, format);
+                secs = timeRepeated([&]() {
+                        return writeHull(work, all, format, fd);
+                }, bytes);
+                cout << "  writer " << name << ":\t" << n / secs / 1e6
+                     << " Mpoints/s, " << bytes / secs / 1e6 << " MB/s\n";
+        }
+        close(fd);
+}
+
+/******** timeRepeated ********
+ *
+ * Times a write by repeating it until at least MIN_TIME seconds pass.
+ *
+ * Parameters:
+ *      const function<size_t()> &write:        Does one write and returns
+ *                                              the bytes written.
+ *      size_t &bytes:                          Set to the bytes written by
+ *                                              one call.
+ * Returns:
+ *      The average seconds per call.
+ * Expects:
+ *      write does the same work every call.
+ * Notes:
+ *      The clock is read once per call, which is small next to a write of
+ *        thousands of points.
+ ************************/
+static double timeRepeated(const function<size_t()> &write, size_t &bytes)
+{
+        int calls = 0;
+        double secs = 0;
+        benchClock::time_point start = benchClock::now();
+        do {
+                bytes = write();
+                calls++;
+                secs = secondsSince(start);
+        } while (secs < MIN_TIME);
+
+        return secs / calls;
+}
+
+/******** benchPacked ********
+ *
+ * Reports the compression ratio and decode speed of packed points, and
+ * times dncPacked against dnc.
+ *
+ * Parameters:
+ *      int n:  The number of random points.
+ * Returns:
+ *      None.
+ * Expects:
+ *      n > 0.
+ * Notes:
+ *      Checks that every block decodes back to the sorted input.
+ ************************/
+static void benchPacked(int n)
+{
+        Points pts = randomPoints(n, RANGE, SEED);
+        sortPoints(pts);
+        double rawBytes = (double) n * sizeof(my_point);
+
+        cout << n << " points, " << rawBytes / 1e6 << " MB as my_point\n";
+
+        for (bool keepIds : {true, false}) {
+                benchClock::time_point start = benchClock::now();
+                PackedPoints packed = packPoints(pts, keepIds);
+                double packTime = secondsSince(start);
+
+                /* Decode every block and check it */
+                Points block(PACK_BLOCK);
+                int wrong = 0;
+                start = benchClock::now();
+                for (size_t b = 0; b < numBlocks(packed); b++) {
+                        int count = unpackBlock(packed, b, block.data());
+                        const my_point *orig = &pts[b * PACK_BLOCK];
+                        for (int k = 0; k < count; k++) {
+                                int id = keepIds ? orig[k].ID :
+                                         (int) (b * PACK_BLOCK + k);
+                                if (block[k].x != orig[k].x ||
+                                    block[k].y != orig[k].y ||
+                                    block[k].ID != id) {
+                                        wrong++;
+                                }
+                        }
+                }
+                double decodeTime = secondsSince(start);
+
+                cout << (keepIds ? "with IDs:" : "no IDs:  ") << "     "
+                     << packed.bytes.size() / 1e6 << " MB, ratio "
+                     << rawBytes / packed.bytes.size() << "x, pack "
+                     << packTime << " s, decode " << n / decodeTime / 1e6
+                     << " Mpoints/s (" << rawBytes / decodeTime / 1e9
+                     << " GB/s), " << wrong << " wrong\n";
+
+                if (!keepIds) continue;
+
+                Points work = pts;
+                start = benchClock::now();
+                Points hull = dnc(work);
+                double dncTime = secondsSince(start);
+
+                start = benchClock::now();
+                Points packedHull = dncPacked(packed);
+                double packedTime = secondsSince(start);
+
+                cout << "dnc:           " << hull.size() << " points in "
+                     << dncTime << " s\n";
+                cout << "dncPacked:     " << packedHull.size()
+                     << " points in " << packedTime << " s, "
+                     << (sameHull(hull, packedHull) ? "same as dnc" :
+                         "differs (dnc does not handle collinear points)")
+                     << "\n";
+        }
+}
+
+/******** benchMerge ********
+ *
+ * Times mergeHulls on the hulls of the left and right halves of the points
+ * against running dnc on all of them, with the visualization left at its
+ * default setting.
+ *
+ * Parameters:
+ *      int n:  The number of random points.
+ * Returns:
+ *      None.
+ * Expects:
+ *      1 < n <= RANGE.
+ * Notes:
+ *      Throws an error if n is out of range or if the merged hull is not the
+ *        hull of the points (checked with isHullOf).
+ *      No window is open and dnc has not drawn anything, so this checks
+ *        that mergeHulls on its own does not try to draw.
+ ************************/
+static void benchMerge(int n)
+{
+        if (n < 2 || n > RANGE) {
+                cerr << "merge needs 2 <= numPoints <= " << RANGE << ".\n";
+                exit(EXIT_FAILURE);
+        }
+        Points pts = distinctPoints(n, RANGE, SEED);
+
+        /* Halves split by a vertical line, as mergeHulls expects */
+        Points left, right;
+        for (int i = 0; i < n; i++) {
+                (pts[i].x < RANGE / 2 ? left : right).push_back(pts[i]);
+        }
+
+        bool wasVisual = setVisualization(false);
+        Points work = pts;
+        benchClock::time_point start = benchClock::now();
+        Points whole = dnc(work);
+        double dncTime = secondsSince(start);
+        Points lHull = left.empty() ? left : dnc(left);
+        Points rHull = right.empty() ? right : dnc(right);
+        setVisualization(wasVisual);
+
+        start = benchClock::now();
+        Points merged = mergeHulls(lHull, rHull);
+        double mergeTime = secondsSince(start);
+
+        bool same = isHullOf(merged, pts);
+        cout << n << " points, " << lHull.size() << " + " << rHull.size()
+             << " hull points merged into " << merged.size() << "\n";
+        cout << "dnc:           " << dncTime << " s\n";
+        cout << "mergeHulls:    " << mergeTime << " s, "
+             << (same ? "matches" : "differs from") << " the reference\n";
+        if (!same) {
+                cerr << "Merged hull differs from the reference hull.\n";
+                exit(EXIT_FAILURE);
+        }
+}
@@ -14,39 +14,59 @@
 #include "assert.h"
 
 #include "dnc.h"
+#include "profile.h"
+#include "render.h"
 
 using namespace std;
 
 typedef pair<int, int> ptPair;
 
+/* A sub-hull stored as indices into the sorted points, read like Points */
+struct IndexHull {
+        const my_point *pts;
+        const int *idx;
+        int n;
+
+        size_t size() const { return n; }
+        bool empty() const { return n == 0; }
+        const my_point &operator[](int k) const { return pts[idx[k]]; }
+};
+
 /* Helper function declarations */
-static void sortPoints(Points &pts);
-static Points solveRecursive(Points &pts, const Points &allPts,
-                             const vector<Points> &prevHulls);
-static ptPair getUpperBridge(const Points &left, const Points &right);
-static ptPair getLowerBridge(const Points &left, const Points &right);
+static Points solveRecursive(Points &pts);
+template <class Hull>
+static ptPair getUpperBridge(const Hull &left, const Hull &right);
+template <class Hull>
+static ptPair getLowerBridge(const Hull &left, const Hull &right);
 static Points merge(const Points &lHull, const Points &rHull, 
                     ptPair upper, ptPair lower);
-static void drawPoints(const Points &pts);
-static void drawAllHulls(const vector<Points> &hulls);
-static void drawSubHulls(const Points &lHull, const Points &rHull,
-                         const Points &allPts, const vector<Points> &prevHulls);
-static void drawMergedHull(const Points &hull, const Points &allPts,
-                           const vector<Points> &prevHulls);
+static int solveIndices(const Points &pts, int *idx, int *scratch, int lo,
+                        int hi);
+static int mergeIndices(const IndexHull &lHull, const IndexHull &rHull,
+                        ptPair upper, ptPair lower, int *out);
+static void drawSubHulls(const Points &lHull, const Points &rHull);
+static void drawMergedHull(const Points &hull, const Points &lHull,
+                           const Points &rHull, size_t mark);
 static void drawHull(const Points &hull, int color);
 static void drawBridgeLine(const my_point &p1, const my_point &p2, int color);
-static int findRightmost(const Points &hull, bool higherY);
-static int findLeftmost(const Points &hull, bool higherY);
-static int crossProduct(const my_point &o, const my_point &a,
-                        const my_point &b);
+template <class Hull>
+static int findRightmost(const Hull &hull, bool higherY);
+template <class Hull>
+static int findLeftmost(const Hull &hull, bool higherY);
 
 /* Define constants and macros */
 const int WAIT = 10;    /* Length of frames in milliseconds */
+static bool visualize = true;   /* Draw each step of the algorithm */
 #define STORED GREEN
 #define SUBHULL BLACK
 #define SEARCH ORANGE
 #define ERASED WHITE
 
+/* What is on screen, so each frame only draws what changed */
+static PointLayer screen;       /* Input points, one per pixel */
+static vector<Points> shown;    /* Stored sub-hulls, erased at next merge */
+static Points lastMerged;       /* Merged hull still drawn in SUBHULL */
+
 /******** dnc ********
  *
  * Wrapper function for the Divide & Conquer convex hull algorithm.
@@ -68,9 +88,123 @@ Points dnc(Points &pts)
                 cerr << "No points given.\n";
                 exit(EXIT_FAILURE);
         }
+
+        /* Same representatives as display(), which drew the unsorted pts */
+        if (visualize) {
+                screen = makePointLayer(pts);
+                shown.clear();
+                lastMerged.clear();
+        }
+
+        profileBegin(PHASE_SORT);
+        sortPoints(pts);
+        profileEnd(PHASE_SORT);
+
+        profileBegin(PHASE_RECURSE);
+        Points hull = solveRecursive(pts);
+        profileEnd(PHASE_RECURSE);
+
+        return hull;
+}
+
+/******** dncIndices ********
+ *
+ * Runs the Divide & Conquer convex hull algorithm without copying points,
+ * returning the hull as indices.
+ *
+ * Parameters:
+ *      Points &pts:            The set of points whose hull will be
+ *                              calculated.
+ *      vector<int> &buf:       Storage for the result, reused across calls.
+ *      IndexBase base:         SORTED_INDEX for indices into the sorted pts,
+ *                              ORIGINAL_INDEX for each point's ID.
+ * Returns:
+ *      A view of the hull indices, in the same order as dnc returns the
+ *      hull. Valid until buf changes.
+ * Expects:
+ *      pts is not empty.
+ * Notes:
+ *      Throws a CRE if pts is empty.
+ *      Sorts pts in place, like dnc. ORIGINAL_INDEX assumes the IDs are the
+ *        input positions, as assigned by readInput.
+ *      Sub-hulls are kept as index ranges inside buf, so the only
+ *        allocations are buf and one scratch array. Runs without the
+ *        visualization.
+ ************************/
+IndexSpan dncIndices(Points &pts, vector<int> &buf, IndexBase base)
+{
+        if (pts.empty()) {
+                cerr << "No points given.\n";
+                exit(EXIT_FAILURE);
+        }
+        profileBegin(PHASE_SORT);
         sortPoints(pts);
-        vector<Points> emptyHulls;
-        return solveRecursive(pts, pts, emptyHulls);
+        profileEnd(PHASE_SORT);
+
+        profileBegin(PHASE_RECURSE);
+        bool wasVisual = visualize;
+        visualize = false;
+        buf.resize(pts.size());
+        vector<int> scratch(pts.size());
+        int size = solveIndices(pts, buf.data(), scratch.data(), 0,
+                                pts.size());
+        buf.resize(size);
+        visualize = wasVisual;
+        profileEnd(PHASE_RECURSE);
+
+        if (base == ORIGINAL_INDEX) {
+                for (int k = 0; k < size; k++) {
+                        buf[k] = pts[buf[k]].ID;
+                }
+        }
+        return {buf.data(), buf.size()};
+}
+
+/******** mergeHulls ********
+ *
+ * Merges two convex hulls that are separated by a vertical line.
+ *
+ * Parameters:
+ *      const Points &lHull:    The left hull, as returned by dnc.
+ *      const Points &rHull:    The right hull, as returned by dnc.
+ * Returns:
+ *      A Points object containing the points of the merged hull.
+ * Expects:
+ *      Every point of lHull has a smaller x-coordinate than every point of
+ *      rHull.
+ * Notes:
+ *      Either hull may be empty, in which case the other is returned.
+ *      Uses the same bridge search and merge as the recursion in dnc.
+ ************************/
+Points mergeHulls(const Points &lHull, const Points &rHull)
+{
+        if (lHull.empty()) return rHull;
+        if (rHull.empty()) return lHull;
+
+        ptPair upper = getUpperBridge(lHull, rHull);
+        ptPair lower = getLowerBridge(lHull, rHull);
+        return merge(lHull, rHull, upper, lower);
+}
+
+/******** setVisualization ********
+ *
+ * Turns the step-by-step drawing of the algorithm on or off.
+ *
+ * Parameters:
+ *      bool on:        True to draw each step, false to run headless.
+ * Returns:
+ *      The previous setting, so a caller can put it back.
+ * Expects:
+ *      None.
+ * Notes:
+ *      Visualization is on by default. Turn it off for batch runs and
+ *        benchmarks, where no window is open.
+ ************************/
+bool setVisualization(bool on)
+{
+        bool was = visualize;
+        visualize = on;
+        return was;
 }
 
 /******** sortPoints ********
@@ -87,7 +221,7 @@ Points dnc(Points &pts)
  * Notes:
  *      Uses std::sort to sort points in O(n log n) time.
  ************************/
-static void sortPoints(Points &pts)
+void sortPoints(Points &pts)
 {
         sort(pts.begin(), pts.end(), [](const my_point &a, const my_point &b) {
                 /* Sort by ascending x-coordinate */
@@ -105,55 +239,51 @@ static void sortPoints(Points &pts)
  * the set, building sub-hulls, and merging them.
  *
  * Parameters:
- *      Points &pts:                            The set of points whose hull
- *                                              will be calculated.
- *      const Points &allPts:                   The original set of points.
- *      const vector<Points> &prevHulls:        A list of all other hulls.
+ *      Points &pts:    The set of points whose hull will be calculated.
  * Returns:
  *      A Points object containing the points of the sub-hull.
  * Expects:
  *      pts is sorted by x-coordinate (ties broken by y-coordinate).
  * Notes:
  *      Calls helper functions to merge and visualize.
+ *      Sub-hulls stored below this level are erased when this level merges.
  ************************/
-static Points solveRecursive(Points &pts, const Points &allPts,
-                             const vector<Points> &prevHulls)
+static Points solveRecursive(Points &pts)
 {
         /* Base (trivial) case: Convex hull of a point is itself */
         if (pts.size() <= 1) {
                 return pts;
         }
         
+        size_t mark = shown.size();
+
         /* Divide the points into two subsets */
         int mid = pts.size() / 2;
         Points lPts(pts.begin(), pts.begin() + mid);
         Points rPts(pts.begin() + mid, pts.end());
         
         /* Recurse to find convex hull of subsets (conquer) */
-        Points lHull = solveRecursive(lPts, allPts, prevHulls);
-        
-        /* Build hull list including left sub-hull for right recursion */
-        vector<Points> withLeftHull = prevHulls;
-        withLeftHull.push_back(lHull);
-        
-        Points rHull = solveRecursive(rPts, allPts, withLeftHull);
-
-        /* Build new hull list including both current sub-hulls */
-        vector<Points> newHulls = withLeftHull;
-        newHulls.push_back(rHull);
+        Points lHull = solveRecursive(lPts);
+        Points rHull = solveRecursive(rPts);
 
         /* Display sub-hulls for incremental visualization */
-        drawSubHulls(lHull, rHull, allPts, newHulls);
+        if (visualize) {
+                drawSubHulls(lHull, rHull);
+        }
 
-        /* Merge */
+        /* Merge; small merges are too short to time and count as recurse */
+        bool timed = pts.size() >= profileMinMerge();
+        if (timed) profileBegin(PHASE_MERGE);
         ptPair upper = getUpperBridge(lHull, rHull);
         ptPair lower = getLowerBridge(lHull, rHull);
         Points merged = merge(lHull, rHull, upper, lower);
+        if (timed) profileEnd(PHASE_MERGE);
         
         /* Draw the merged hull */
-        en47_wait(WAIT);
-        en47_clear();
-        drawMergedHull(merged, allPts, newHulls);
+        if (visualize) {
+                en47_wait(WAIT);
+                drawMergedHull(merged, lHull, rHull, mark);
+        }
         
         return merged;
 }
@@ -163,8 +293,8 @@ static Points solveRecursive(Points &pts, const Points &allPts,
  * Finds the upper bridge between two separated convex hulls.
  *
  * Parameters:
- *      const Points &left:     The left sub-hull (CW order).
- *      const Points &right:    The right sub-hull (CW order).
+ *      const Hull &left:       The left sub-hull (CW order).
+ *      const Hull &right:      The right sub-hull (CW order).
  * Returns:
  *      Indices {left, right} of the bridge.
  * Expects:
@@ -172,8 +302,10 @@ static Points solveRecursive(Points &pts, const Points &allPts,
  *      left and right are sorted by x-coordinate relative to each other.
  * Notes:
  *      Draws searching process in ORANGE.
+ *      Hull is Points or IndexHull.
  ************************/
-static ptPair getUpperBridge(const Points &left, const Points &right)
+template <class Hull>
+static ptPair getUpperBridge(const Hull &left, const Hull &right)
 {
         assert(!left.empty());
         assert(!right.empty());
@@ -220,8 +352,8 @@ static ptPair getUpperBridge(const Points &left, const Points &right)
  * Finds the lower bridge between two separated convex hulls.
  *
  * Parameters:
- *      const Points &left:     The left sub-hull (sorted CW).
- *      const Points &right:    The right sub-hull (sorted CW).
+ *      const Hull &left:       The left sub-hull (sorted CW).
+ *      const Hull &right:      The right sub-hull (sorted CW).
  * Returns:
  *      Indices {left, right} of the bridge.
  * Expects:
@@ -229,8 +361,10 @@ static ptPair getUpperBridge(const Points &left, const Points &right)
  *      left and right are sorted by x-coordinate relative to each other.
  * Notes:
  *      Draws searching process in ORANGE.
+ *      Hull is Points or IndexHull.
  ************************/
-static ptPair getLowerBridge(const Points &left, const Points &right)
+template <class Hull>
+static ptPair getLowerBridge(const Hull &left, const Hull &right)
 {
         assert(!left.empty());
         assert(!right.empty());
@@ -322,44 +456,94 @@ static Points merge(const Points &lHull, const Points &rHull,
         return merged;
 }
 
-/******** drawPoints ********
+/******** solveIndices ********
  *
- * Draws all points in the point set.
+ * Recursively builds the convex hull of a range of sorted points, storing
+ * the hull as indices.
  *
  * Parameters:
- *      const Points &pts:      The set of points to draw.
+ *      const Points &pts:      The sorted set of points.
+ *      int *idx:               Receives the hull of [lo, hi) at idx[lo].
+ *      int *scratch:           Scratch space the size of pts.
+ *      int lo, hi:             The range of points to solve.
  * Returns:
- *      None.
+ *      The number of points in the hull.
  * Expects:
- *      None.
+ *      pts is sorted by x-coordinate (ties broken by y-coordinate).
  * Notes:
- *      Draws points in BLACK.
+ *      Splits at the same midpoint as solveRecursive and uses the same
+ *        bridge search, so the hull matches dnc's point for point.
+ *      A hull never has more points than its range, so each sub-hull fits
+ *        in place at the start of its own range.
  ************************/
-static void drawPoints(const Points &pts)
+static int solveIndices(const Points &pts, int *idx, int *scratch, int lo,
+                        int hi)
 {
-        for (size_t i = 0; i < pts.size(); i++) {
-                en47_draw_point(pts[i].x, pts[i].y, BLACK);
+        /* Base (trivial) case: Convex hull of a point is itself */
+        if (hi - lo <= 1) {
+                idx[lo] = lo;
+                return hi - lo;
         }
+
+        int mid = lo + (hi - lo) / 2;
+        int lSize = solveIndices(pts, idx, scratch, lo, mid);
+        int rSize = solveIndices(pts, idx, scratch, mid, hi);
+
+        IndexHull lHull = {pts.data(), idx + lo, lSize};
+        IndexHull rHull = {pts.data(), idx + mid, rSize};
+
+        /* Small merges are too short to time and count as recurse */
+        bool timed = (size_t) (hi - lo) >= profileMinMerge();
+        if (timed) profileBegin(PHASE_MERGE);
+        ptPair upper = getUpperBridge(lHull, rHull);
+        ptPair lower = getLowerBridge(lHull, rHull);
+        int size = mergeIndices(lHull, rHull, upper, lower, scratch + lo);
+        copy(scratch + lo, scratch + lo + size, idx + lo);
+        if (timed) profileEnd(PHASE_MERGE);
+
+        return size;
 }
 
-/******** drawAllHulls ********
+/******** mergeIndices ********
  *
- * Draws all previous sub-hulls.
+ * Index version of merge: writes the merged hull's indices to out.
  *
  * Parameters:
- *      const vector<Points> &hulls:    Vector of all previous hulls.
+ *      const IndexHull &lHull: The left sub-hull.
+ *      const IndexHull &rHull: The right sub-hull.
+ *      ptPair upper:           Indices of the upper bridge {l, r}.
+ *      ptPair lower:           Indices of the lower bridge {l, r}.
+ *      int *out:               Receives the merged hull.
  * Returns:
- *      None.
+ *      The number of points in the merged hull.
  * Expects:
- *      None.
+ *      out has room for lHull.size() + rHull.size() indices and does not
+ *      overlap either hull.
  * Notes:
- *      Draws all hulls in GREEN.
+ *      Visits the sub-hulls in the same order as merge.
  ************************/
-static void drawAllHulls(const vector<Points> &hulls)
+static int mergeIndices(const IndexHull &lHull, const IndexHull &rHull,
+                        ptPair upper, ptPair lower, int *out)
 {
-        for (size_t i = 0; i < hulls.size(); i++) {
-                drawHull(hulls[i], STORED);
+        int size = 0;
+
+        /* Traverse right hull (upper -> lower bridge, CW) */
+        int ind = upper.second;
+        while (true) {
+                out[size++] = rHull.idx[ind];
+                if (ind == lower.second) break;
+                ind = (ind + 1) % rHull.n;
+        }
+
+        /* Traverse left hull (lower -> upper bridge, CW) */
+        ind = lower.first;
+        while (true) {
+                out[size++] = lHull.idx[ind];
+                if (ind == upper.first) break;
+                ind = (ind + 1) % lHull.n;
         }
+
+        return size;
 }
 
 /******** drawSubHulls ********
@@ -367,22 +551,19 @@ static void drawAllHulls(const vector<Points> &hulls)
  * Draws the current left and right sub-hulls.
  *
  * Parameters:
- *      const Points &lHull:                    The left sub-hull.
- *      const Points &rHull:                    The right sub-hull.
- *      const Points &allPts:                   The original set of points.
- *      const vector<Points> &prevHulls:        A list of all other hulls.
+ *      const Points &lHull:    The left sub-hull.
+ *      const Points &rHull:    The right sub-hull.
  * Returns:
  *      None.
  * Expects:
  *      None.
  * Notes:
- *      Draws current sub-hulls in BLACK and previous ones in GREEN.
+ *      Draws current sub-hulls in BLACK and turns the last merged hull GREEN.
+ *      Draws over the previous frame rather than clearing it.
  ************************/
-static void drawSubHulls(const Points &lHull, const Points &rHull,
-                         const Points &allPts, const vector<Points> &prevHulls)
+static void drawSubHulls(const Points &lHull, const Points &rHull)
 {
-        drawPoints(allPts);
-        drawAllHulls(prevHulls);
+        drawHull(lastMerged, STORED);
         drawHull(lHull, SUBHULL);
         drawHull(rHull, SUBHULL);
         en47_wait(WAIT);
@@ -390,25 +571,45 @@ static void drawSubHulls(const Points &lHull, const Points &rHull,
 
 /******** drawMergedHull ********
  *
- * Draws the complete merged hull in BLACK.
+ * Erases the sub-hulls of the level below and draws the merged hull.
  *
  * Parameters:
- *      const Points &hull:                     A merged convex hull.
- *      const Points &allPts:                   The original set of points.
- *      const vector<Points> &prevHulls:        A list of all other hulls.
+ *      const Points &hull:     A merged convex hull.
+ *      const Points &lHull:    The left sub-hull.
+ *      const Points &rHull:    The right sub-hull.
+ *      size_t mark:            Size of shown when this merge's level began.
  * Returns:
  *      None.
  * Expects:
- *      None.
+ *      Every hull in shown past mark lies inside hull.
  * Notes:
- *      Draws hulls in BLACK.
+ *      Redraws only the pixels under erased lines, so a frame costs about
+ *        the length of what changed instead of the whole picture.
+ *      Draws the sub-hulls in GREEN and the merged hull in BLACK.
  ************************/
-static void drawMergedHull(const Points &hull, const Points &allPts,
-                           const vector<Points> &prevHulls)
+static void drawMergedHull(const Points &hull, const Points &lHull,
+                           const Points &rHull, size_t mark)
 {
-        drawPoints(allPts);
-        drawAllHulls(prevHulls);
-        drawHull(hull, SUBHULL);
+        /* Erase stored hulls that are now inside the merged hull */
+        for (size_t k = mark; k < shown.size(); k++) {
+                const Points &old = shown[k];
+                drawHull(old, ERASED);
+                for (size_t i = 0; i < old.size(); i++) {
+                        markErased(screen, old[i], old[(i + 1) % old.size()]);
+                }
+        }
+        shown.resize(mark);
+
+        /* Put back the points the erased lines covered */
+        repairErased(screen, BLACK);
+
+        shown.push_back(decimateHull(lHull, screen.raster));
+        shown.push_back(decimateHull(rHull, screen.raster));
+        drawHull(shown[shown.size() - 2], STORED);
+        drawHull(shown.back(), STORED);
+
+        lastMerged = decimateHull(hull, screen.raster);
+        drawHull(lastMerged, SUBHULL);
 }
 
 /******** drawHull ********
@@ -423,13 +624,14 @@ static void drawMergedHull(const Points &hull, const Points &allPts,
  * Expects:
  *      None.
  * Notes:
- *      None.
+ *      Skips edges shorter than a pixel.
  ************************/
 static void drawHull(const Points &hull, int color)
 {
-        for (size_t i = 0; i < hull.size(); i++) {
-                const my_point &p = hull[i];
-                const my_point &next = hull[(i + 1) % hull.size()];
+        Points outline = decimateHull(hull, screen.raster);
+        for (size_t i = 0; i < outline.size(); i++) {
+                const my_point &p = outline[i];
+                const my_point &next = outline[(i + 1) % outline.size()];
                 en47_draw_segment(p.x, p.y, next.x, next.y, color);
         }
 }
@@ -447,15 +649,21 @@ static void drawHull(const Points &hull, int color)
  * Expects:
  *      None.
  * Notes:
- *      None.
+ *      Erased lines are remembered so the points under them can be redrawn.
+ *      Draws nothing until dnc has built the screen layer, so mergeHulls
+ *        can be called on its own without a window.
  ************************/
 static void drawBridgeLine(const my_point &p1, const my_point &p2, int color)
 {
+        if (!visualize || screen.dirty.empty()) return;
+
         en47_draw_segment(p1.x, p1.y, p2.x, p2.y, color);
         
         /* Wait if searching, do not wait if erasing */
         if (color == SEARCH) {
                 en47_wait(WAIT);
+        } else if (color == ERASED) {
+                markErased(screen, p1, p2);
         }
 }
 
@@ -464,7 +672,7 @@ static void drawBridgeLine(const my_point &p1, const my_point &p2, int color)
  * Finds the rightmost point in a hull (for upper bridges, ties go to higher y).
  *
  * Parameters:
- *      const Points &hull:     The hull to search.
+ *      const Hull &hull:       The hull to search.
  *      bool higherY:           If true, tie-break with higher y (upper bridge).
  *                              If false, tie-break with lower y (lower bridge).
  * Returns:
@@ -472,9 +680,10 @@ static void drawBridgeLine(const my_point &p1, const my_point &p2, int color)
  * Expects:
  *      hull is not empty.
  * Notes:
- *      None.
+ *      Hull is Points or IndexHull.
  ************************/
-static int findRightmost(const Points &hull, bool higherY)
+template <class Hull>
+static int findRightmost(const Hull &hull, bool higherY)
 {
         int ind = 0;
         for (int k = 1; k < (int)hull.size(); k++) {
@@ -496,7 +705,7 @@ static int findRightmost(const Points &hull, bool higherY)
  * Finds the leftmost point in a hull (for upper bridges, ties go to higher y).
  *
  * Parameters:
- *      const Points &hull:     The hull to search.
+ *      const Hull &hull:       The hull to search.
  *      bool higherY:           If true, tie-break with higher y (upper bridge).
  *                              If false, tie-break with lower y (lower bridge).
  * Returns:
@@ -504,9 +713,10 @@ static int findRightmost(const Points &hull, bool higherY)
  * Expects:
  *      hull is not empty.
  * Notes:
- *      None.
+ *      Hull is Points or IndexHull.
  ************************/
-static int findLeftmost(const Points &hull, bool higherY)
+template <class Hull>
+static int findLeftmost(const Hull &hull, bool higherY)
 {
         int ind = 0;
         for (int k = 1; k < (int)hull.size(); k++) {
@@ -539,8 +749,8 @@ static int findLeftmost(const Points &hull, bool higherY)
  * Notes:
  *      None.
  ************************/
-static int crossProduct(const my_point &o, const my_point &a,
-                        const my_point &b)
+int crossProduct(const my_point &o, const my_point &a,
+                 const my_point &b)
 {
         return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
 }
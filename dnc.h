@@ -19,7 +19,24 @@ using namespace std;
 
 typedef vector<my_point> Points;
 
+/* A read-only view of hull indices, owned by the caller's buffer */
+struct IndexSpan {
+        const int *data;
+        size_t size;
+};
+
+/* What the indices returned by dncIndices refer to */
+enum IndexBase {
+        SORTED_INDEX,           /* Positions in the sorted point array */
+        ORIGINAL_INDEX          /* my_point.ID, the original input position */
+};
+
 /* Function Declarations */
 Points dnc(Points &pts);
+IndexSpan dncIndices(Points &pts, vector<int> &buf, IndexBase base);
+Points mergeHulls(const Points &lHull, const Points &rHull);
+bool setVisualization(bool on);
+void sortPoints(Points &pts);
+int crossProduct(const my_point &o, const my_point &a, const my_point &b);
 
 #endif
@@ -0,0 +1,313 @@
+/*
+ *      layers.cpp
+ *      Justin Paik (jpaik03)
+ *      11 December, 2025
+ *      Divide & Conquer Convex Hull Algorithm
+ *
+ *      Contains function definitions for computing the convex layers (onion
+ *      peeling) of a set of points. The points are sorted once and split
+ *      into a hull tree: every node stores the hull of its range of the
+ *      sorted points, built from the hulls of its two children. Peeling a
+ *      layer only rebuilds the nodes whose hull lost a point.
+ */
+
+/* Standard c++ Includes */
+#include <iostream>
+#include <algorithm>
+#include "assert.h"
+
+#include "layers.h"
+
+using namespace std;
+
+/* Points per leaf of the hull tree */
+const int LEAF_SIZE = 16;
+
+/* The hull tree over the distinct sorted points */
+struct HullTree {
+        Points pts;                     /* Distinct points, sorted */
+        vector<char> alive;             /* Whether each point is unpeeled */
+        vector<vector<int>> hull;       /* Sorted indices on each node's hull */
+        vector<int> cand, stack;        /* Scratch space for rebuilds */
+        vector<char> onHull;
+};
+
+/* Helper function declarations */
+static void buildTree(HullTree &tree, int node, int lo, int hi);
+static void repairTree(HullTree &tree, int node, int lo, int hi);
+static void rebuildNode(HullTree &tree, int node, int lo, int hi);
+static void markHull(const Points &pts, const vector<int> &cand,
+                     vector<int> &stack, vector<char> &onHull);
+static void buildChain(const Points &pts, const vector<int> &cand,
+                       vector<int> &stack, int start, int end, int step);
+static bool samePoint(const my_point &a, const my_point &b);
+
+/******** convexLayers ********
+ *
+ * Computes the convex layers of a set of points by repeatedly peeling off the
+ * outermost hull.
+ *
+ * Parameters:
+ *      Points &pts:    The set of points to peel.
+ * Returns:
+ *      A vector indexed by my_point.ID holding the layer of each point, where
+ *      layer 0 is the outermost hull.
+ * Expects:
+ *      pts is not empty.
+ *      Every ID is in [0, pts.size()), as assigned by readInput.
+ * Notes:
+ *      Throws a CRE if pts is empty.
+ *      Sorts pts in place, like dnc. The sort is done once. Each layer is
+ *        the hull at the root of the hull tree; after it is peeled, only the
+ *        nodes that held one of its points are rebuilt, each from the hulls
+ *        of its children.
+ *      Points lying on a hull edge belong to that hull's layer.
+ *      Duplicate points all get the same layer.
+ ************************/
+vector<int> convexLayers(Points &pts)
+{
+        if (pts.empty()) {
+                cerr << "No points given.\n";
+                exit(EXIT_FAILURE);
+        }
+        sortPoints(pts);
+
+        /* Keep one copy of each position; group[k] is where copy k starts */
+        HullTree tree;
+        vector<int> group;
+        for (size_t i = 0; i < pts.size(); i++) {
+                if (i == 0 || !samePoint(pts[i], pts[i - 1])) {
+                        group.push_back(i);
+                        tree.pts.push_back(pts[i]);
+                }
+        }
+        group.push_back(pts.size());
+
+        int m = tree.pts.size();
+        tree.alive.assign(m, 1);
+        tree.hull.resize(2 * m);
+        buildTree(tree, 0, 0, m);
+
+        vector<int> layer(pts.size(), -1);
+        for (int depth = 0; !tree.hull[0].empty(); depth++) {
+                /* Record this layer and remove its points */
+                const vector<int> &outer = tree.hull[0];
+                for (size_t k = 0; k < outer.size(); k++) {
+                        int u = outer[k];
+                        tree.alive[u] = 0;
+                        for (int i = group[u]; i < group[u + 1]; i++) {
+                                assert(pts[i].ID >= 0 &&
+                                       pts[i].ID < (int) layer.size());
+                                layer[pts[i].ID] = depth;
+                        }
+                }
+                repairTree(tree, 0, 0, m);
+        }
+
+        return layer;
+}
+
+/******** buildTree ********
+ *
+ * Builds the hull of every node below and including one node.
+ *
+ * Parameters:
+ *      HullTree &tree:         The tree being built.
+ *      int node:               The node covering points [lo, hi).
+ *      int lo:                 Index of the node's first point.
+ *      int hi:                 Index one past the node's last point.
+ * Returns:
+ *      None.
+ * Expects:
+ *      lo < hi.
+ * Notes:
+ *      The left child of node is node + 1 and the right child is
+ *        node + 2 * (mid - lo), so the tree uses fewer than 2 * n nodes.
+ ************************/
+static void buildTree(HullTree &tree, int node, int lo, int hi)
+{
+        if (hi - lo > LEAF_SIZE) {
+                int mid = lo + (hi - lo) / 2;
+                buildTree(tree, node + 1, lo, mid);
+                buildTree(tree, node + 2 * (mid - lo), mid, hi);
+        }
+        rebuildNode(tree, node, lo, hi);
+}
+
+/******** repairTree ********
+ *
+ * Rebuilds the hulls that lost a point in the last peel.
+ *
+ * Parameters:
+ *      HullTree &tree:         The tree to repair.
+ *      int node:               The node covering points [lo, hi).
+ *      int lo:                 Index of the node's first point.
+ *      int hi:                 Index one past the node's last point.
+ * Returns:
+ *      None.
+ * Expects:
+ *      Every point removed since the last repair was on the root's hull.
+ * Notes:
+ *      A point on the hull of all the points is on the hull of every range
+ *        holding it, so a node with no removed point on its hull is still
+ *        correct and its whole subtree is skipped.
+ ************************/
+static void repairTree(HullTree &tree, int node, int lo, int hi)
+{
+        const vector<int> &hull = tree.hull[node];
+        bool stale = false;
+        for (size_t k = 0; k < hull.size() && !stale; k++) {
+                stale = !tree.alive[hull[k]];
+        }
+        if (!stale) return;
+
+        if (hi - lo > LEAF_SIZE) {
+                int mid = lo + (hi - lo) / 2;
+                repairTree(tree, node + 1, lo, mid);
+                repairTree(tree, node + 2 * (mid - lo), mid, hi);
+        }
+        rebuildNode(tree, node, lo, hi);
+}
+
+/******** rebuildNode ********
+ *
+ * Recomputes the hull of one node.
+ *
+ * Parameters:
+ *      HullTree &tree:         The tree holding the node.
+ *      int node:               The node covering points [lo, hi).
+ *      int lo:                 Index of the node's first point.
+ *      int hi:                 Index one past the node's last point.
+ * Returns:
+ *      None.
+ * Expects:
+ *      The hulls of the node's children are up to date.
+ * Notes:
+ *      A leaf scans its live points. Any other node only looks at the points
+ *        on its children's hulls, since every point on its own hull is on
+ *        one of theirs. Both lists are sorted and the left one comes first.
+ ************************/
+static void rebuildNode(HullTree &tree, int node, int lo, int hi)
+{
+        vector<int> &cand = tree.cand;
+        cand.clear();
+        if (hi - lo > LEAF_SIZE) {
+                int mid = lo + (hi - lo) / 2;
+                const vector<int> &left = tree.hull[node + 1];
+                const vector<int> &right = tree.hull[node + 2 * (mid - lo)];
+                cand.insert(cand.end(), left.begin(), left.end());
+                cand.insert(cand.end(), right.begin(), right.end());
+        } else {
+                for (int i = lo; i < hi; i++) {
+                        if (tree.alive[i]) cand.push_back(i);
+                }
+        }
+
+        vector<int> &hull = tree.hull[node];
+        hull.clear();
+        if (cand.empty()) return;
+
+        markHull(tree.pts, cand, tree.stack, tree.onHull);
+        for (size_t k = 0; k < cand.size(); k++) {
+                if (tree.onHull[k]) hull.push_back(cand[k]);
+        }
+}
+
+/******** markHull ********
+ *
+ * Flags every point that lies on the convex hull of a sorted set of points.
+ *
+ * Parameters:
+ *      const Points &pts:      The points that cand indexes into.
+ *      const vector<int> &cand:        Indices of the points to use, in
+ *                                      sorted order.
+ *      vector<int> &stack:     Scratch space for the hull chains.
+ *      vector<char> &onHull:   Set to 1 for hull points and 0 otherwise,
+ *                              indexed like cand.
+ * Returns:
+ *      None.
+ * Expects:
+ *      cand is not empty and its points are distinct and sorted by
+ *      x-coordinate (ties broken by y-coordinate).
+ * Notes:
+ *      Builds the lower and upper chains in O(cand.size()) since the points
+ *        are already sorted.
+ ************************/
+static void markHull(const Points &pts, const vector<int> &cand,
+                     vector<int> &stack, vector<char> &onHull)
+{
+        assert(!cand.empty());
+
+        int n = cand.size();
+        onHull.assign(n, 0);
+
+        /* Lower chain, left to right */
+        buildChain(pts, cand, stack, 0, n, 1);
+        for (size_t k = 0; k < stack.size(); k++) {
+                onHull[stack[k]] = 1;
+        }
+
+        /* Upper chain, right to left */
+        buildChain(pts, cand, stack, n - 1, -1, -1);
+        for (size_t k = 0; k < stack.size(); k++) {
+                onHull[stack[k]] = 1;
+        }
+}
+
+/******** buildChain ********
+ *
+ * Builds one monotone chain of the hull, keeping collinear points.
+ *
+ * Parameters:
+ *      const Points &pts:      The points that cand indexes into.
+ *      const vector<int> &cand:        Indices of the points, in sorted
+ *                                      order.
+ *      vector<int> &stack:     Filled with the positions in cand of the
+ *                              chain.
+ *      int start:              Position of the first point to visit.
+ *      int end:                Position one past the last point to visit.
+ *      int step:               1 to walk left to right, -1 for right to left.
+ * Returns:
+ *      None.
+ * Expects:
+ *      The points of cand are distinct and sorted by x-coordinate (ties
+ *      broken by y-coordinate).
+ * Notes:
+ *      Pops only on a clockwise (right) turn, so points on a hull edge stay
+ *        on the chain.
+ *      Duplicates must be removed first, since the cross product of a
+ *        duplicate is 0 and would pin an interior point to the chain.
+ ************************/
+static void buildChain(const Points &pts, const vector<int> &cand,
+                       vector<int> &stack, int start, int end, int step)
+{
+        stack.clear();
+        for (int i = start; i != end; i += step) {
+                while (stack.size() >= 2 &&
+                       crossProduct(pts[cand[stack[stack.size() - 2]]],
+                                    pts[cand[stack.back()]],
+                                    pts[cand[i]]) < 0) {
+                        stack.pop_back();
+                }
+                stack.push_back(i);
+        }
+}
+
+/******** samePoint ********
+ *
+ * Checks whether two points have the same coordinates.
+ *
+ * Parameters:
+ *      const my_point &a:      The first point.
+ *      const my_point &b:      The second point.
+ * Returns:
+ *      True if a and b are at the same position, whatever their IDs.
+ * Expects:
+ *      None.
+ * Notes:
+ *      None.
+ ************************/
+static bool samePoint(const my_point &a, const my_point &b)
+{
+        return a.x == b.x && a.y == b.y;
+}
@@ -0,0 +1,23 @@
+/*
+ *      layers.h
+ *      Justin Paik (jpaik03)
+ *      11 December, 2025
+ *      Divide & Conquer Convex Hull Algorithm
+ *
+ *      Contains function declarations for computing the convex layers (onion
+ *      peeling) of a set of points.
+ */
+
+#ifndef LAYERS_H
+#define LAYERS_H
+
+#include <vector>
+
+#include "dnc.h"
+
+using namespace std;
+
+/* Function Declarations */
+vector<int> convexLayers(Points &pts);
+
+#endif
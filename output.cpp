@@ -0,0 +1,144 @@
+/*
+ *      output.cpp
+ *      Justin Paik (jpaik03)
+ *      11 December, 2025
+ *      Divide & Conquer Convex Hull Algorithm
+ *
+ *      Contains function definitions for the buffered hull output writer.
+ *      Numbers are formatted with std::to_chars into a fixed buffer that is
+ *      handed to write(2) when full, instead of streaming each point through
+ *      cout.
+ */
+
+/* Standard c++ Includes */
+#include <iostream>
+#include <charconv>
+#include <cstring>
+#include <cerrno>
+#include "assert.h"
+
+/* POSIX Includes */
+#include <unistd.h>
+
+#include "output.h"
+
+using namespace std;
+
+/* Define constants */
+const size_t BUFFER_SIZE = 1 << 16;
+const int MAX_INT_CHARS = 11;   /* "-2147483648" */
+const size_t MAX_RECORD = 32;   /* Longest text record: "(x, y)\n" */
+
+/* Helper function declarations */
+static void flushBuffer(int fd, const char *buf, size_t len);
+
+/******** parseFormat ********
+ *
+ * Converts a format name to an OutputFormat.
+ *
+ * Parameters:
+ *      const string &name:     "text", "binary", or "ids".
+ *      OutputFormat &format:   Set to the matching format.
+ * Returns:
+ *      True if name is a known format.
+ * Expects:
+ *      None.
+ * Notes:
+ *      Leaves format unchanged if name is unknown.
+ ************************/
+bool parseFormat(const string &name, OutputFormat &format)
+{
+        if (name == "text") format = FORMAT_TEXT;
+        else if (name == "binary") format = FORMAT_BINARY;
+        else if (name == "ids") format = FORMAT_IDS;
+        else return false;
+        return true;
+}
+
+/******** writeHull ********
+ *
+ * Writes the points of a hull to a file descriptor.
+ *
+ * Parameters:
+ *      const Points &pts:      The points the hull indices refer to.
+ *      IndexSpan hull:         Indices into pts, as from dncIndices.
+ *      OutputFormat format:    How to write each point.
+ *      int fd:                 The file descriptor to write to.
+ * Returns:
+ *      The number of bytes written.
+ * Expects:
+ *      Every index in hull is a valid position in pts.
+ * Notes:
+ *      Throws an error if writing fails.
+ *      Does not go through cout, so flush cout first when mixing the two on
+ *        the same descriptor.
+ ************************/
+size_t writeHull(const Points &pts, IndexSpan hull, OutputFormat format,
+                 int fd)
+{
+        char buf[BUFFER_SIZE];
+        size_t len = 0, total = 0;
+
+        for (size_t k = 0; k < hull.size; k++) {
+                if (len + MAX_RECORD > BUFFER_SIZE) {
+                        flushBuffer(fd, buf, len);
+                        total += len;
+                        len = 0;
+                }
+
+                assert(hull.data[k] >= 0 && hull.data[k] < (int) pts.size());
+                const my_point &p = pts[hull.data[k]];
+                char *out = buf + len;
+
+                if (format == FORMAT_TEXT) {
+                        *out++ = '(';
+                        out = to_chars(out, out + MAX_INT_CHARS, p.x).ptr;
+                        *out++ = ',';
+                        *out++ = ' ';
+                        out = to_chars(out, out + MAX_INT_CHARS, p.y).ptr;
+                        *out++ = ')';
+                        *out++ = '\n';
+                } else if (format == FORMAT_IDS) {
+                        out = to_chars(out, out + MAX_INT_CHARS, p.ID).ptr;
+                        *out++ = '\n';
+                } else {
+                        int record[3] = {p.x, p.y, p.ID};
+                        memcpy(out, record, sizeof(record));
+                        out += sizeof(record);
+                }
+                len = out - buf;
+        }
+
+        flushBuffer(fd, buf, len);
+        return total + len;
+}
+
+/******** flushBuffer ********
+ *
+ * Writes a whole buffer to a file descriptor.
+ *
+ * Parameters:
+ *      int fd:                 The file descriptor to write to.
+ *      const char *buf:        The bytes to write.
+ *      size_t len:             The number of bytes.
+ * Returns:
+ *      None.
+ * Expects:
+ *      None.
+ * Notes:
+ *      Retries short and interrupted writes. Throws an error if writing
+ *        fails.
+ ************************/
+static void flushBuffer(int fd, const char *buf, size_t len)
+{
+        while (len > 0) {
+                ssize_t n = write(fd, buf, len);
+                if (n < 0 && errno == EINTR) continue;
+                if (n <= 0) {
+                        cerr << "Error: could not write output.\n";
+                        exit(EXIT_FAILURE);
+                }
+                buf += n;
+                len -= n;
+        }
+}
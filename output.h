@@ -0,0 +1,31 @@
+/*
+ *      output.h
+ *      Justin Paik (jpaik03)
+ *      11 December, 2025
+ *      Divide & Conquer Convex Hull Algorithm
+ *
+ *      Contains function declarations for the buffered hull output writer.
+ */
+
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+#include <string>
+
+#include "dnc.h"
+
+using namespace std;
+
+/* Ways to write a hull */
+enum OutputFormat {
+        FORMAT_TEXT,            /* "(x, y)" lines, like printPoints */
+        FORMAT_BINARY,          /* Raw x, y, ID ints in native byte order */
+        FORMAT_IDS              /* One ID per line */
+};
+
+/* Function Declarations */
+bool parseFormat(const string &name, OutputFormat &format);
+size_t writeHull(const Points &pts, IndexSpan hull, OutputFormat format,
+                 int fd);
+
+#endif
@@ -0,0 +1,368 @@
+/*
+ *      packed.cpp
+ *      Justin Paik (jpaik03)
+ *      11 December, 2025
+ *      Divide & Conquer Convex Hull Algorithm
+ *
+ *      Contains function definitions for compressed storage of sorted
+ *      points. After sortPoints, consecutive x values are close, so storing
+ *      the differences at a per-block bit width takes a few bytes per point
+ *      instead of the 12 of a my_point.
+ */
+
+/* Standard c++ Includes */
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+#include "assert.h"
+
+#include "packed.h"
+
+using namespace std;
+
+/* Block header: the first point, then the bit width of each field */
+struct BlockHeader {
+        int32_t x, y, ID;
+        uint8_t xBits, yBits, idBits;
+        uint8_t unused;
+};
+
+static_assert(sizeof(BlockHeader) == 16, "block header must be packed");
+
+/* Define constants */
+const int SLACK = 8;    /* Bytes past the end so reads can load a word */
+
+/* Helper function declarations */
+static uint64_t zigzag(int64_t v);
+static int64_t unzigzag(uint64_t v);
+static int bitWidth(uint64_t v);
+static void putBits(vector<uint8_t> &bytes, uint64_t &bitPos, uint64_t v,
+                    int bits);
+static uint64_t getBits(const uint8_t *bytes, uint64_t &bitPos, int bits);
+
+/******** packPoints ********
+ *
+ * Compresses a sorted set of points.
+ *
+ * Parameters:
+ *      const Points &pts:      The set of points, sorted by sortPoints.
+ *      bool keepIds:           If false, IDs are dropped and decode as each
+ *                              point's position in pts.
+ * Returns:
+ *      The compressed points.
+ * Expects:
+ *      pts is sorted by x-coordinate (ties broken by y-coordinate).
+ * Notes:
+ *      x changes are never negative, so they are stored as is. y and ID
+ *        changes are zigzag-encoded so small negative changes stay small.
+ ************************/
+PackedPoints packPoints(const Points &pts, bool keepIds)
+{
+        PackedPoints packed;
+        packed.count = pts.size();
+        packed.hasIds = keepIds;
+
+        for (size_t first = 0; first < pts.size(); first += PACK_BLOCK) {
+                size_t last = min(first + PACK_BLOCK, pts.size());
+
+                /* Find the widest change in this block */
+                uint64_t xMax = 0, yMax = 0, idMax = 0;
+                for (size_t i = first + 1; i < last; i++) {
+                        assert(pts[i].x >= pts[i - 1].x);
+                        xMax |= (uint64_t) ((int64_t) pts[i].x - pts[i - 1].x);
+                        yMax |= zigzag((int64_t) pts[i].y - pts[i - 1].y);
+                        idMax |= zigzag((int64_t) pts[i].ID - pts[i - 1].ID);
+                }
+
+                BlockHeader header;
+                header.x = pts[first].x;
+                header.y = pts[first].y;
+                header.ID = keepIds ? pts[first].ID : 0;
+                header.xBits = bitWidth(xMax);
+                header.yBits = bitWidth(yMax);
+                header.idBits = keepIds ? bitWidth(idMax) : 0;
+                header.unused = 0;
+
+                packed.blockStart.push_back(packed.bytes.size());
+                const uint8_t *raw = (const uint8_t *) &header;
+                packed.bytes.insert(packed.bytes.end(), raw,
+                                    raw + sizeof(header));
+
+                uint64_t bitPos = packed.bytes.size() * 8;
+                for (size_t i = first + 1; i < last; i++) {
+                        putBits(packed.bytes, bitPos,
+                                (int64_t) pts[i].x - pts[i - 1].x,
+                                header.xBits);
+                        putBits(packed.bytes, bitPos,
+                                zigzag((int64_t) pts[i].y - pts[i - 1].y),
+                                header.yBits);
+                        putBits(packed.bytes, bitPos,
+                                zigzag((int64_t) pts[i].ID - pts[i - 1].ID),
+                                header.idBits);
+                }
+                packed.bytes.resize((bitPos + 7) / 8);
+        }
+
+        packed.bytes.resize(packed.bytes.size() + SLACK, 0);
+        return packed;
+}
+
+/******** numBlocks ********
+ *
+ * Returns the number of blocks in a compressed point set.
+ *
+ * Parameters:
+ *      const PackedPoints &packed:     The compressed points.
+ * Returns:
+ *      The number of blocks.
+ * Expects:
+ *      None.
+ * Notes:
+ *      Every block but the last holds PACK_BLOCK points.
+ ************************/
+size_t numBlocks(const PackedPoints &packed)
+{
+        return packed.blockStart.size();
+}
+
+/******** unpackBlock ********
+ *
+ * Decodes one block of compressed points.
+ *
+ * Parameters:
+ *      const PackedPoints &packed:     The compressed points.
+ *      size_t block:                   The block to decode.
+ *      my_point *out:                  Receives the points of the block.
+ * Returns:
+ *      The number of points decoded.
+ * Expects:
+ *      block < numBlocks(packed) and out has room for PACK_BLOCK points.
+ * Notes:
+ *      Reads each field with one unaligned 64-bit load.
+ ************************/
+int unpackBlock(const PackedPoints &packed, size_t block, my_point *out)
+{
+        assert(block < numBlocks(packed));
+
+        size_t first = block * PACK_BLOCK;
+        int count = min<size_t>(PACK_BLOCK, packed.count - first);
+
+        BlockHeader header;
+        memcpy(&header, &packed.bytes[packed.blockStart[block]],
+               sizeof(header));
+        uint64_t bitPos = (packed.blockStart[block] + sizeof(header)) * 8;
+        const uint8_t *bytes = packed.bytes.data();
+
+        int x = header.x, y = header.y, id = header.ID;
+        for (int k = 0; k < count; k++) {
+                if (k > 0) {
+                        x += getBits(bytes, bitPos, header.xBits);
+                        y += unzigzag(getBits(bytes, bitPos, header.yBits));
+                        id += unzigzag(getBits(bytes, bitPos,
+                                               header.idBits));
+                }
+                out[k].x = x;
+                out[k].y = y;
+                out[k].ID = packed.hasIds ? id : (int) (first + k);
+        }
+        return count;
+}
+
+/******** dncPacked ********
+ *
+ * Builds the convex hull of compressed points, decoding one block at a
+ * time.
+ *
+ * Parameters:
+ *      const PackedPoints &packed:     The compressed points.
+ * Returns:
+ *      A Points object containing the points of the convex hull.
+ * Expects:
+ *      packed is not empty.
+ * Notes:
+ *      Throws a CRE if packed is empty.
+ *      Each block's hull is built with dnc, then merged with the blocks
+ *        before it like a binary counter, so only one decoded block and
+ *        O(log n) sub-hulls are in memory at once.
+ *      Points sharing the x-coordinate at the end of a block are moved to
+ *        the next block, since the bridge merge needs hulls separated by a
+ *        vertical line.
+ *      Turns the visualization off while solving and restores it before
+ *        returning.
+ ************************/
+Points dncPacked(const PackedPoints &packed)
+{
+        if (packed.count == 0) {
+                cerr << "No points given.\n";
+                exit(EXIT_FAILURE);
+        }
+        bool wasVisual = setVisualization(false);
+
+        Points block, carry;
+        vector<Points> hulls;
+        vector<int> sizes;      /* Blocks covered by each hull */
+
+        for (size_t b = 0; b < numBlocks(packed); b++) {
+                block = carry;
+                block.resize(carry.size() + PACK_BLOCK);
+                int count = unpackBlock(packed, b, &block[carry.size()]);
+                block.resize(carry.size() + count);
+
+                /* Hold back points sharing the last x so hulls never touch */
+                carry.clear();
+                if (b + 1 < numBlocks(packed)) {
+                        size_t cut = block.size();
+                        while (cut > 0 && block[cut - 1].x == block.back().x) {
+                                cut--;
+                        }
+                        carry.assign(block.begin() + cut, block.end());
+                        block.resize(cut);
+                }
+                if (block.empty()) continue;
+
+                hulls.push_back(dnc(block));
+                sizes.push_back(1);
+
+                /* Merge equal-sized neighbours, left to right */
+                while (hulls.size() >= 2 &&
+                       sizes[sizes.size() - 2] == sizes.back()) {
+                        Points merged = mergeHulls(hulls[hulls.size() - 2],
+                                                   hulls.back());
+                        hulls.pop_back();
+                        hulls.back() = merged;
+                        sizes.pop_back();
+                        sizes.back() *= 2;
+                }
+        }
+
+        /* Merge what is left, right to left */
+        while (hulls.size() >= 2) {
+                Points merged = mergeHulls(hulls[hulls.size() - 2],
+                                           hulls.back());
+                hulls.pop_back();
+                hulls.back() = merged;
+        }
+
+        setVisualization(wasVisual);
+        return hulls[0];
+}
+
+/******** zigzag ********
+ *
+ * Maps a signed value to an unsigned one so that small magnitudes stay
+ * small: 0, -1, 1, -2, ... become 0, 1, 2, 3, ...
+ *
+ * Parameters:
+ *      int64_t v:      The signed value.
+ * Returns:
+ *      The zigzag-encoded value.
+ * Expects:
+ *      None.
+ * Notes:
+ *      None.
+ ************************/
+static uint64_t zigzag(int64_t v)
+{
+        return ((uint64_t) v << 1) ^ (uint64_t) (v >> 63);
+}
+
+/******** unzigzag ********
+ *
+ * Reverses zigzag.
+ *
+ * Parameters:
+ *      uint64_t v:     The zigzag-encoded value.
+ * Returns:
+ *      The signed value.
+ * Expects:
+ *      None.
+ * Notes:
+ *      None.
+ ************************/
+static int64_t unzigzag(uint64_t v)
+{
+        return (int64_t) (v >> 1) ^ -(int64_t) (v & 1);
+}
+
+/******** bitWidth ********
+ *
+ * Finds the number of bits needed to hold a value.
+ *
+ * Parameters:
+ *      uint64_t v:     The value.
+ * Returns:
+ *      The position of the highest set bit plus one, or 0 for 0.
+ * Expects:
+ *      None.
+ * Notes:
+ *      None.
+ ************************/
+static int bitWidth(uint64_t v)
+{
+        int bits = 0;
+        while (v != 0) {
+                bits++;
+                v >>= 1;
+        }
+        return bits;
+}
+
+/******** putBits ********
+ *
+ * Appends the low bits of a value to a bit stream.
+ *
+ * Parameters:
+ *      vector<uint8_t> &bytes: The stream, grown as needed.
+ *      uint64_t &bitPos:       The next bit to write; advanced by bits.
+ *      uint64_t v:             The value to write.
+ *      int bits:               How many low bits of v to write.
+ * Returns:
+ *      None.
+ * Expects:
+ *      bits <= 56 and v fits in bits.
+ * Notes:
+ *      Bits are stored least significant first.
+ ************************/
+static void putBits(vector<uint8_t> &bytes, uint64_t &bitPos, uint64_t v,
+                    int bits)
+{
+        if (bits == 0) return;
+        assert(bits <= 56);
+
+        size_t need = (bitPos + bits + 7) / 8;
+        if (bytes.size() < need) bytes.resize(need, 0);
+
+        for (int b = 0; b < bits; b += 8) {
+                uint64_t pos = bitPos + b;
+                uint64_t chunk = (v >> b) << (pos % 8);
+                bytes[pos / 8] |= chunk & 0xff;
+                if (pos / 8 + 1 < bytes.size()) {
+                        bytes[pos / 8 + 1] |= (chunk >> 8) & 0xff;
+                }
+        }
+        bitPos += bits;
+}
+
+/******** getBits ********
+ *
+ * Reads the next value from a bit stream.
+ *
+ * Parameters:
+ *      const uint8_t *bytes:   The stream.
+ *      uint64_t &bitPos:       The next bit to read; advanced by bits.
+ *      int bits:               How many bits to read.
+ * Returns:
+ *      The value.
+ * Expects:
+ *      bits <= 56 and the stream has SLACK bytes past the last value.
+ * Notes:
+ *      None.
+ ************************/
+static uint64_t getBits(const uint8_t *bytes, uint64_t &bitPos, int bits)
+{
+        uint64_t word;
+        memcpy(&word, bytes + bitPos / 8, sizeof(word));
+        uint64_t v = (word >> (bitPos % 8)) & ((1ULL << bits) - 1);
+        bitPos += bits;
+        return v;
+}
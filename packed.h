@@ -0,0 +1,43 @@
+/*
+ *      packed.h
+ *      Justin Paik (jpaik03)
+ *      11 December, 2025
+ *      Divide & Conquer Convex Hull Algorithm
+ *
+ *      Contains the data structure and function declarations for compressed
+ *      storage of sorted points.
+ */
+
+#ifndef PACKED_H
+#define PACKED_H
+
+#include <vector>
+#include <cstdint>
+
+#include "dnc.h"
+
+using namespace std;
+
+/* Points per block; every block can be decoded on its own */
+const int PACK_BLOCK = 256;
+
+/*
+ * Sorted points cut into blocks of PACK_BLOCK. Each block stores its first
+ * point as is, then the change from one point to the next, bit-packed at
+ * the smallest width that fits the whole block. Block b starts at byte
+ * blockStart[b] of bytes.
+ */
+struct PackedPoints {
+        size_t count;
+        bool hasIds;            /* If false, IDs decode as sorted positions */
+        vector<uint64_t> blockStart;
+        vector<uint8_t> bytes;
+};
+
+/* Function Declarations */
+PackedPoints packPoints(const Points &pts, bool keepIds);
+size_t numBlocks(const PackedPoints &packed);
+int unpackBlock(const PackedPoints &packed, size_t block, my_point *out);
+Points dncPacked(const PackedPoints &packed);
+
+#endif
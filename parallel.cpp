@@ -0,0 +1,57 @@
+/*
+ *      parallel.cpp
+ *      Justin Paik (jpaik03)
+ *      11 December, 2025
+ *      Divide & Conquer Convex Hull Algorithm
+ *
+ *      Contains function definitions for running independent pieces of work
+ *      on several threads.
+ */
+
+/* Standard c++ Includes */
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#include "parallel.h"
+
+using namespace std;
+
+/******** parallelFor ********
+ *
+ * Calls body(i) for every i in [0, count), spread across the hardware
+ * threads.
+ *
+ * Parameters:
+ *      int count:                              The number of work items.
+ *      const function<void(int)> &body:        The work for a single item.
+ * Returns:
+ *      None.
+ * Expects:
+ *      body(i) and body(j) are safe to run at the same time for i != j.
+ * Notes:
+ *      Thread t handles items t, t + numThreads, t + 2 * numThreads, ...
+ *      Runs on the calling thread alone when there is one item or one core.
+ ************************/
+void parallelFor(int count, const function<void(int)> &body)
+{
+        int numThreads = min<int>(thread::hardware_concurrency(), count);
+        if (numThreads <= 1) {
+                for (int i = 0; i < count; i++) {
+                        body(i);
+                }
+                return;
+        }
+
+        vector<thread> workers;
+        for (int t = 0; t < numThreads; t++) {
+                workers.emplace_back([&body, t, numThreads, count]() {
+                        for (int i = t; i < count; i += numThreads) {
+                                body(i);
+                        }
+                });
+        }
+        for (size_t t = 0; t < workers.size(); t++) {
+                workers[t].join();
+        }
+}
@@ -0,0 +1,21 @@
+/*
+ *      parallel.h
+ *      Justin Paik (jpaik03)
+ *      11 December, 2025
+ *      Divide & Conquer Convex Hull Algorithm
+ *
+ *      Contains function declarations for running independent pieces of work
+ *      on several threads.
+ */
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <functional>
+
+using namespace std;
+
+/* Function Declarations */
+void parallelFor(int count, const function<void(int)> &body);
+
+#endif
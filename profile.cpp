@@ -0,0 +1,447 @@
+/*
+ *      profile.cpp
+ *      Justin Paik (jpaik03)
+ *      11 December, 2025
+ *      Divide & Conquer Convex Hull Algorithm
+ *
+ *      Contains function definitions for profiling each phase of the solver.
+ *      Counts cycles, instructions, cache misses, and branch misses with
+ *      Linux perf_event_open, and falls back to wall-clock time alone when
+ *      the counters are unavailable. Where the kernel allows it, the counters
+ *      are read with rdpmc through their mmap pages instead of a read call.
+ */
+
+/* Standard c++ Includes */
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <chrono>
+#include <cstring>
+#include <cstdint>
+#include <atomic>
+#include "assert.h"
+
+/* Linux Includes for the performance counters */
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "profile.h"
+
+using namespace std;
+
+typedef chrono::steady_clock profileClock;
+
+/* Define constants */
+const int NUM_COUNTERS = 4;
+const char *const COUNTER_NAMES[NUM_COUNTERS] = {
+        "cycles", "instructions", "cache-miss", "branch-miss"
+};
+const uint64_t COUNTER_CONFIGS[NUM_COUNTERS] = {
+        PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+        PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES
+};
+const char *const PHASE_NAMES[NUM_PHASES] = {
+        "load", "sort", "recurse", "merge", "output"
+};
+
+/* Smallest merge, in points, timed as merge when a sample is a few rdpmc
+ * instructions, and when it is a system call */
+const size_t CHEAP_MIN_MERGE = 1 << 6;
+const size_t SYSCALL_MIN_MERGE = 1 << 12;
+
+/* Profiler state */
+static bool enabled = false;
+static int groupFd = -1;                        /* -1 if no counters */
+static int slot[NUM_COUNTERS];                  /* -1 if unavailable */
+static int numOpen = 0;
+static perf_event_mmap_page *page[NUM_COUNTERS];  /* nullptr if unmapped */
+static size_t minMerge = SIZE_MAX;              /* Until profileStart */
+static double phaseTime[NUM_PHASES];            /* Seconds */
+static uint64_t phaseCount[NUM_PHASES][NUM_COUNTERS];
+static vector<Phase> active;                    /* Nested phases */
+static profileClock::time_point lastTime;
+static uint64_t lastCount[NUM_COUNTERS];
+
+/* Helper function declarations */
+static int openCounter(uint64_t config, int leader);
+static bool canReadMapped();
+static void sample(profileClock::time_point &now, uint64_t *counts);
+static bool readMapped(uint64_t *counts);
+static bool readPage(const volatile perf_event_mmap_page *pc,
+                     uint64_t &count);
+#if defined(__x86_64__) || defined(__i386__)
+static uint64_t readPmc(uint32_t counter);
+#endif
+static void charge(Phase phase);
+
+/******** profileStart ********
+ *
+ * Turns profiling on and opens the hardware counters.
+ *
+ * Parameters:
+ *      None.
+ * Returns:
+ *      None.
+ * Expects:
+ *      Called once, before any phase begins.
+ * Notes:
+ *      Prints a warning and keeps wall-clock timing if the counters cannot
+ *        be opened (no PMU, or perf_event_paranoid is too strict).
+ *      Counts user-space events of this thread only, and is not safe to
+ *        use while dnc runs on several threads.
+ *      Maps each counter's page so it can be read with rdpmc, and sets the
+ *        merge threshold from how cheap a sample turns out to be.
+ ************************/
+void profileStart()
+{
+        enabled = true;
+        memset(phaseTime, 0, sizeof(phaseTime));
+        memset(phaseCount, 0, sizeof(phaseCount));
+        long pageSize = sysconf(_SC_PAGESIZE);
+
+        /* The first counter that opens leads the group */
+        for (int c = 0; c < NUM_COUNTERS; c++) {
+                page[c] = nullptr;
+                int fd = openCounter(COUNTER_CONFIGS[c], groupFd);
+                if (fd < 0) {
+                        slot[c] = -1;
+                        continue;
+                }
+                if (groupFd < 0) groupFd = fd;
+                slot[c] = numOpen++;
+
+                void *map = mmap(nullptr, pageSize, PROT_READ, MAP_SHARED,
+                                 fd, 0);
+                if (map != MAP_FAILED) {
+                        page[c] = (perf_event_mmap_page *) map;
+                }
+        }
+
+        if (groupFd < 0) {
+                cerr << "Warning: hardware counters unavailable, "
+                     << "profiling wall-clock time only.\n";
+                minMerge = CHEAP_MIN_MERGE;
+                return;
+        }
+        ioctl(groupFd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(groupFd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        minMerge = canReadMapped() ? CHEAP_MIN_MERGE : SYSCALL_MIN_MERGE;
+}
+
+/******** profileMinMerge ********
+ *
+ * Gives the smallest merge worth timing as its own phase.
+ *
+ * Parameters:
+ *      None.
+ * Returns:
+ *      The size, in points, below which a merge is counted as recurse.
+ * Expects:
+ *      None.
+ * Notes:
+ *      SIZE_MAX until profileStart is called, so nothing is timed.
+ *      Timing a merge takes two samples. With rdpmc (or the clock alone) a
+ *        sample costs about as much as a merge of a few points, so only the
+ *        merges near the leaves are skipped. With a read call per sample,
+ *        only merges of thousands of points are long enough to time.
+ ************************/
+size_t profileMinMerge()
+{
+        return minMerge;
+}
+
+/******** profileBegin ********
+ *
+ * Marks the start of a phase.
+ *
+ * Parameters:
+ *      Phase phase:    The phase that is starting.
+ * Returns:
+ *      None.
+ * Expects:
+ *      Matched by a later profileEnd(phase).
+ * Notes:
+ *      Phases may nest. Work done inside an inner phase is charged to the
+ *        inner phase only, so recurse excludes its merges.
+ *      Does nothing unless profileStart was called.
+ ************************/
+void profileBegin(Phase phase)
+{
+        if (!enabled) return;
+
+        if (!active.empty()) charge(active.back());
+        else sample(lastTime, lastCount);
+        active.push_back(phase);
+}
+
+/******** profileEnd ********
+ *
+ * Marks the end of a phase.
+ *
+ * Parameters:
+ *      Phase phase:    The phase that is ending.
+ * Returns:
+ *      None.
+ * Expects:
+ *      phase is the innermost phase that has begun and not ended.
+ * Notes:
+ *      Does nothing unless profileStart was called.
+ ************************/
+void profileEnd(Phase phase)
+{
+        if (!enabled) return;
+
+        assert(!active.empty() && active.back() == phase);
+        charge(phase);
+        active.pop_back();
+}
+
+/******** printProfile ********
+ *
+ * Prints a table of the time and counter totals of each phase to cerr.
+ *
+ * Parameters:
+ *      None.
+ * Returns:
+ *      None.
+ * Expects:
+ *      All phases have ended.
+ * Notes:
+ *      Prints n/a for counters that could not be opened.
+ ************************/
+void printProfile()
+{
+        if (!enabled) return;
+
+        cerr << left << setw(10) << "phase" << right << setw(12) << "ms";
+        for (int c = 0; c < NUM_COUNTERS; c++) {
+                cerr << setw(15) << COUNTER_NAMES[c];
+        }
+        cerr << setw(8) << "IPC" << "\n";
+
+        for (int p = 0; p < NUM_PHASES; p++) {
+                cerr << left << setw(10) << PHASE_NAMES[p] << right
+                     << setw(12) << fixed << setprecision(3)
+                     << phaseTime[p] * 1000;
+                for (int c = 0; c < NUM_COUNTERS; c++) {
+                        if (slot[c] < 0) cerr << setw(15) << "n/a";
+                        else cerr << setw(15) << phaseCount[p][c];
+                }
+
+                uint64_t cycles = phaseCount[p][0];
+                uint64_t instructions = phaseCount[p][1];
+                if (slot[0] < 0 || slot[1] < 0 || cycles == 0) {
+                        cerr << setw(8) << "n/a" << "\n";
+                } else {
+                        cerr << setw(8) << setprecision(2)
+                             << (double) instructions / cycles << "\n";
+                }
+        }
+        cerr.unsetf(ios::fixed);
+        cerr << "merge times merges of at least " << minMerge
+             << " points; smaller ones count as recurse.\n";
+}
+
+/******** openCounter ********
+ *
+ * Opens one hardware counter for the calling thread.
+ *
+ * Parameters:
+ *      uint64_t config:        The PERF_COUNT_HW_* event to count.
+ *      int leader:             The group leader's fd, or -1 to start a
+ *                              group.
+ * Returns:
+ *      The counter's file descriptor, or -1 on failure.
+ * Expects:
+ *      None.
+ * Notes:
+ *      The leader starts disabled; the whole group is enabled at once.
+ ************************/
+static int openCounter(uint64_t config, int leader)
+{
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = config;
+        attr.disabled = (leader < 0);
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+
+        return syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0);
+}
+
+/******** canReadMapped ********
+ *
+ * Checks whether every open counter can be read without a system call.
+ *
+ * Parameters:
+ *      None.
+ * Returns:
+ *      True if the counters are mapped and readMapped succeeds.
+ * Expects:
+ *      The group is enabled.
+ * Notes:
+ *      cap_user_rdpmc is only valid once the counters are running, so this
+ *        is checked after they are enabled.
+ ************************/
+static bool canReadMapped()
+{
+        uint64_t counts[NUM_COUNTERS];
+        return readMapped(counts);
+}
+
+/******** sample ********
+ *
+ * Reads the clock and the current counter values.
+ *
+ * Parameters:
+ *      profileClock::time_point &now:  Set to the current time.
+ *      uint64_t *counts:               Set to the NUM_COUNTERS totals.
+ * Returns:
+ *      None.
+ * Expects:
+ *      None.
+ * Notes:
+ *      Reads the counters with rdpmc if it can, and otherwise reads the
+ *        whole group with one read call. Leaves counts at 0 if there are no
+ *        counters.
+ ************************/
+static void sample(profileClock::time_point &now, uint64_t *counts)
+{
+        memset(counts, 0, NUM_COUNTERS * sizeof(uint64_t));
+        if (groupFd >= 0 && !readMapped(counts)) {
+                uint64_t buf[1 + NUM_COUNTERS];
+                if (read(groupFd, buf, sizeof(buf)) > 0) {
+                        for (int c = 0; c < NUM_COUNTERS; c++) {
+                                if (slot[c] >= 0) {
+                                        counts[c] = buf[1 + slot[c]];
+                                }
+                        }
+                }
+        }
+        now = profileClock::now();
+}
+
+/******** readMapped ********
+ *
+ * Reads every open counter through its mmap page.
+ *
+ * Parameters:
+ *      uint64_t *counts:       Set to the NUM_COUNTERS totals.
+ * Returns:
+ *      True on success, false if any counter must be read with a system
+ *      call instead.
+ * Expects:
+ *      None.
+ * Notes:
+ *      counts may be partly written on failure.
+ ************************/
+static bool readMapped(uint64_t *counts)
+{
+        for (int c = 0; c < NUM_COUNTERS; c++) {
+                if (slot[c] < 0) continue;
+                if (page[c] == nullptr || !readPage(page[c], counts[c])) {
+                        return false;
+                }
+        }
+        return true;
+}
+
+/******** readPage ********
+ *
+ * Reads one counter with rdpmc, following the protocol in
+ * linux/perf_event.h.
+ *
+ * Parameters:
+ *      const volatile perf_event_mmap_page *pc:        The counter's page.
+ *      uint64_t &count:        Set to the counter's total.
+ * Returns:
+ *      True on success, false if rdpmc is not allowed, the counter is not
+ *      on the PMU right now, or this is not an x86 machine.
+ * Expects:
+ *      pc is mapped from a counter of the calling thread.
+ * Notes:
+ *      The kernel bumps pc->lock while it updates the page, so the read is
+ *        retried until the lock is the same before and after it.
+ *      The hardware counter is only pmc_width bits wide; its value is
+ *        sign-extended and added to the kernel's running offset.
+ ************************/
+static bool readPage(const volatile perf_event_mmap_page *pc,
+                     uint64_t &count)
+{
+#if defined(__x86_64__) || defined(__i386__)
+        uint32_t seq;
+        do {
+                seq = pc->lock;
+                atomic_signal_fence(memory_order_seq_cst);
+
+                uint32_t index = pc->index;
+                if (!pc->cap_user_rdpmc || index == 0) return false;
+
+                int shift = 64 - pc->pmc_width;
+                uint64_t pmc = readPmc(index - 1) << shift;
+                count = pc->offset + (uint64_t) ((int64_t) pmc >> shift);
+
+                atomic_signal_fence(memory_order_seq_cst);
+        } while (pc->lock != seq);
+        return true;
+#else
+        (void) pc;
+        (void) count;
+        return false;
+#endif
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+/******** readPmc ********
+ *
+ * Reads a hardware counter register.
+ *
+ * Parameters:
+ *      uint32_t counter:       The register, one less than the page's index.
+ * Returns:
+ *      The raw register value.
+ * Expects:
+ *      The kernel allows rdpmc for this thread (cap_user_rdpmc).
+ * Notes:
+ *      Faults if rdpmc is not allowed, so only readPage calls it.
+ ************************/
+static uint64_t readPmc(uint32_t counter)
+{
+        uint32_t lo, hi;
+        asm volatile("rdpmc" : "=a"(lo), "=d"(hi) : "c"(counter));
+        return lo | ((uint64_t) hi << 32);
+}
+#endif
+
+/******** charge ********
+ *
+ * Adds the time and counts since the last sample to a phase.
+ *
+ * Parameters:
+ *      Phase phase:    The phase to charge.
+ * Returns:
+ *      None.
+ * Expects:
+ *      lastTime and lastCount hold the previous sample.
+ * Notes:
+ *      Takes a new sample, which becomes the previous one.
+ ************************/
+static void charge(Phase phase)
+{
+        profileClock::time_point now;
+        uint64_t counts[NUM_COUNTERS];
+        sample(now, counts);
+
+        phaseTime[phase] += chrono::duration<double>(now - lastTime).count();
+        for (int c = 0; c < NUM_COUNTERS; c++) {
+                phaseCount[phase][c] += counts[c] - lastCount[c];
+        }
+        lastTime = now;
+        memcpy(lastCount, counts, sizeof(counts));
+}
@@ -0,0 +1,33 @@
+/*
+ *      profile.h
+ *      Justin Paik (jpaik03)
+ *      11 December, 2025
+ *      Divide & Conquer Convex Hull Algorithm
+ *
+ *      Contains function declarations for profiling each phase of the solver
+ *      with hardware performance counters.
+ */
+
+#ifndef PROFILE_H
+#define PROFILE_H
+
+using namespace std;
+
+/* Solver phases that are timed separately */
+enum Phase {
+        PHASE_LOAD,
+        PHASE_SORT,
+        PHASE_RECURSE,
+        PHASE_MERGE,
+        PHASE_OUTPUT,
+        NUM_PHASES
+};
+
+/* Function Declarations */
+void profileStart();
+size_t profileMinMerge();
+void profileBegin(Phase phase);
+void profileEnd(Phase phase);
+void printProfile();
+
+#endif
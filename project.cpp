@@ -13,12 +13,19 @@
 #include <iostream>
 #include <fstream>
 #include <vector>
+#include <chrono>
 #include "assert.h"
+#include <unistd.h>
 
 /* Professor Souvaine's LEDA library */
 #include "en47_vis_txt.h"
 
 #include "dnc.h"
+#include "layers.h"
+#include "approx.h"
+#include "profile.h"
+#include "output.h"
+#include "render.h"
 
 using namespace std;
 
@@ -28,6 +35,10 @@ typedef vector<my_point> Points;
 void readInput(string inputFile, Points &pts);
 void printPoints(const Points &pts);
 void display(const Points &pts, const Points &hull);
+void printLayers(Points &pts);
+void showApprox(const Points &pts, double eps);
+void runProfile(string inputFile);
+void writeIndexed(Points &pts, OutputFormat format);
 
 int main(int argc, char *argv[])
 {
@@ -35,8 +46,30 @@ int main(int argc, char *argv[])
         
         if (argc == 2) {
                 readInput(argv[1], pts);
+        } else if (argc == 3 && string(argv[1]) == "--layers") {
+                readInput(argv[2], pts);
+                printLayers(pts);
+                return 0;
+        } else if (argc == 4 && string(argv[1]) == "--approx") {
+                readInput(argv[3], pts);
+                showApprox(pts, atof(argv[2]));
+                return 0;
+        } else if (argc == 3 && string(argv[1]) == "--profile") {
+                runProfile(argv[2]);
+                return 0;
+        } else if (argc == 4 && string(argv[1]) == "--format") {
+                OutputFormat format;
+                if (!parseFormat(argv[2], format)) {
+                        cerr << "Unknown format: " << argv[2] << "\n";
+                        exit(EXIT_FAILURE);
+                }
+                readInput(argv[3], pts);
+                writeIndexed(pts, format);
+                return 0;
         } else {
-                cerr << "Usage: ./dnc_ch inputFile\n";
+                cerr << "Usage: ./dnc_ch [--layers | --approx eps | "
+                     << "--profile | --format text|binary|ids] "
+                     << "inputFile\n";
                 exit(EXIT_FAILURE);
         }
 
@@ -115,7 +148,8 @@ void readInput(string inputFile, Points &pts)
  * Expects:
  *      None.
  * Notes:
- *      None.
+ *      Draws one point per occupied pixel and skips hull edges shorter than
+ *        a pixel, so drawing time does not grow with the number of points.
  ************************/
 void display(const Points &pts, const Points &hull)
 {
@@ -142,18 +176,17 @@ void display(const Points &pts, const Points &hull)
         /* Display */
         en47_display(minX - mar, maxX + mar, minY - mar, maxY + mar);
         
-        /* Draw input points */
-        for (size_t i = 0; i < pts.size(); i++) {
-                p = pts[i];
-                en47_draw_point(p.x, p.y, BLACK);
-        }
+        /* Draw input points, one per occupied pixel */
+        PointLayer layer = makePointLayer(pts);
+        drawPointLayer(layer, BLACK);
 
         /* Draw hull lines */
-        if (!hull.empty()) {
-                for (size_t i = 0; i < hull.size(); i++) {
+        Points outline = decimateHull(hull, layer.raster);
+        if (!outline.empty()) {
+                for (size_t i = 0; i < outline.size(); i++) {
                         /* Wrap around to connect the last point to the first */
-                        const my_point &p1 = hull[i];
-                        const my_point &p2 = hull[(i + 1) % hull.size()];
+                        const my_point &p1 = outline[i];
+                        const my_point &p2 = outline[(i + 1) % outline.size()];
                         en47_draw_segment(p1.x, p1.y, p2.x, p2.y, BLUE);
                 }
         }
@@ -186,3 +219,144 @@ void printPoints(const Points &pts)
                 cout << "(" << p.x << ", " << p.y << ")\n";
         }
 }
+
+/******** printLayers ********
+ *
+ * Computes the convex layers of a set of points and prints the layer of each
+ * point.
+ *
+ * Parameters:
+ *      Points &pts:    The set of points to peel.
+ * Returns:
+ *      None.
+ * Expects:
+ *      pts is not empty and was populated by readInput.
+ * Notes:
+ *      Prints one "ID layer" line per point in input order, where layer 0 is
+ *        the outermost hull. Runs without the visualization.
+ ************************/
+void printLayers(Points &pts)
+{
+        setVisualization(false);
+        vector<int> layer = convexLayers(pts);
+
+        int depth = 0;
+        for (size_t i = 0; i < layer.size(); i++) {
+                if (layer[i] + 1 > depth) depth = layer[i] + 1;
+        }
+        cout << pts.size() << " total points in " << depth << " layers:\n";
+
+        for (size_t i = 0; i < layer.size(); i++) {
+                cout << i << " " << layer[i] << "\n";
+        }
+}
+
+/******** showApprox ********
+ *
+ * Builds an approximate convex hull, prints it with its error, and displays
+ * it.
+ *
+ * Parameters:
+ *      const Points &pts:      The set of points.
+ *      double eps:             The largest error allowed.
+ * Returns:
+ *      None.
+ * Expects:
+ *      pts is not empty and eps > 0.
+ * Notes:
+ *      Skips the step-by-step visualization and shows only the result.
+ *      Closes the window on mouse click.
+ ************************/
+void showApprox(const Points &pts, double eps)
+{
+        ApproxStats stats;
+        Points hull = approxHull(pts, eps, &stats);
+
+        cout << pts.size() << " total points, " << stats.strips
+             << " strips.\n";
+        cout << "Error bound " << stats.bound << ", measured error "
+             << stats.error << ".\n";
+        cout << hull.size() << " points in approximate hull (CCW order):\n";
+        printPoints(hull);
+
+        display(pts, hull);
+        en47_mouse_wait();
+        en47_close();
+}
+
+/******** runProfile ********
+ *
+ * Runs the solver without the visualization and prints a table of hardware
+ * counters for each phase.
+ *
+ * Parameters:
+ *      string inputFile:       Filename of a file containing a set of points.
+ * Returns:
+ *      None.
+ * Expects:
+ *      inputFile is a valid filename.
+ * Notes:
+ *      The hull goes to cout and the table to cerr.
+ *      Phases are load, sort, recurse (excluding merges), merge, and output.
+ *        Only merges of at least profileMinMerge() points are timed as
+ *        merge; smaller ones count as recurse.
+ ************************/
+void runProfile(string inputFile)
+{
+        setVisualization(false);
+        profileStart();
+
+        Points pts;
+        profileBegin(PHASE_LOAD);
+        readInput(inputFile, pts);
+        profileEnd(PHASE_LOAD);
+
+        Points hull = dnc(pts);
+
+        profileBegin(PHASE_OUTPUT);
+        cout << hull.size() << " points in hull (CCW order):\n";
+        printPoints(hull);
+        cout.flush();
+        profileEnd(PHASE_OUTPUT);
+
+        cerr << pts.size() << " total points.\n";
+        printProfile();
+}
+
+/******** writeIndexed ********
+ *
+ * Computes the hull as indices and writes it to stdout with the buffered
+ * writer.
+ *
+ * Parameters:
+ *      Points &pts:            The set of points. Sorted in place.
+ *      OutputFormat format:    How to write each hull point.
+ * Returns:
+ *      None.
+ * Expects:
+ *      pts is not empty.
+ * Notes:
+ *      Runs without the visualization. No hull points are copied.
+ *      Reports the output size and throughput on cerr, so stdout holds only
+ *        the hull.
+ ************************/
+void writeIndexed(Points &pts, OutputFormat format)
+{
+        setVisualization(false);
+        vector<int> buf;
+        IndexSpan hull = dncIndices(pts, buf, SORTED_INDEX);
+
+        cout.flush();
+        chrono::steady_clock::time_point start = chrono::steady_clock::now();
+        size_t bytes = writeHull(pts, hull, format, STDOUT_FILENO);
+        double secs = chrono::duration<double>(chrono::steady_clock::now() -
+                                               start).count();
+
+        cerr << hull.size << " points in hull, " << bytes << " bytes in "
+             << secs * 1000 << " ms";
+        if (secs > 0) {
+                cerr << " (" << bytes / secs / 1e6 << " MB/s, "
+                     << hull.size / secs << " points/s)";
+        }
+        cerr << ".\n";
+}
@@ -0,0 +1,635 @@
+/*
+ *      pyramid.cpp
+ *      Justin Paik (jpaik03)
+ *      11 December, 2025
+ *      Divide & Conquer Convex Hull Algorithm
+ *
+ *      Contains function definitions for the hull pyramid. Tile hulls are
+ *      built with dnc and every block of tiles is built from the two halves
+ *      below it with the same bridge merge, so a query over a range of tiles
+ *      only merges O(log^2) precomputed hulls instead of rerunning dnc on
+ *      the raw points.
+ */
+
+/* Standard c++ Includes */
+#include <iostream>
+#include <fstream>
+#include <algorithm>
+#include <cstring>
+#include "assert.h"
+
+/* POSIX Includes for memory mapping */
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "pyramid.h"
+#include "parallel.h"
+
+using namespace std;
+
+/* On-disk layout: header, offsets[numNodes + 1], then the hull points */
+struct PyramidHeader {
+        char magic[8];
+        int32_t originX, originY;
+        int32_t tileW, tileH;
+        int32_t cols, rows;
+        int32_t levelsX, levelsY;
+        uint64_t numNodes;
+        uint64_t numPts;
+};
+
+static_assert(sizeof(PyramidHeader) % 8 == 0, "header must keep alignment");
+static_assert(sizeof(my_point) == 3 * sizeof(int32_t), "my_point is packed");
+
+const char MAGIC[8] = "DNCPYR2";
+
+/* Helper function declarations */
+static void setLevels(HullPyramid &pyr);
+static bool validHeader(const PyramidHeader *header, size_t size);
+static bool validOffsets(const uint64_t *offsets, uint64_t numNodes,
+                         uint64_t numPts);
+static int nodeIndex(const HullPyramid &pyr, int lx, int ly, int c, int r);
+static const uint64_t *offsetsOf(const HullPyramid &pyr);
+static const my_point *pointsOf(const HullPyramid &pyr);
+static Points nodeHull(const HullPyramid &pyr, int node);
+static Points mergeAbove(const Points &bottom, const Points &top);
+static Points rotate(const Points &hull, bool clockwise);
+static void splitRange(int lo, int hi, int levels, vector<int> &level,
+                       vector<int> &index);
+
+/******** buildPyramid ********
+ *
+ * Buckets points into a grid of tiles and builds the hull pyramid bottom-up.
+ *
+ * Parameters:
+ *      const Points &pts:      The set of points to index.
+ *      int originX, originY:   Bottom-left corner of tile (0, 0).
+ *      int tileW, tileH:       Size of one tile.
+ *      int cols, rows:         Number of tiles across and up.
+ * Returns:
+ *      A HullPyramid that owns its hulls.
+ * Expects:
+ *      tileW, tileH, cols, and rows are positive, and cols and rows are
+ *      at most MAX_GRID.
+ *      Every point lies inside the grid.
+ * Notes:
+ *      Turns the visualization off while building, since the hulls are built
+ *        on several threads, and restores it before returning.
+ *      Tile (c, r) holds the points with originX + c * tileW <= x <
+ *        originX + (c + 1) * tileW, and likewise for y. Tiles are strictly
+ *        separated, which is what the bridge merge needs.
+ ************************/
+HullPyramid buildPyramid(const Points &pts, int originX, int originY,
+                         int tileW, int tileH, int cols, int rows)
+{
+        assert(tileW > 0 && tileH > 0 && cols > 0 && rows > 0);
+        assert(cols <= MAX_GRID && rows <= MAX_GRID);
+        bool wasVisual = setVisualization(false);
+
+        HullPyramid pyr;
+        pyr.originX = originX;
+        pyr.originY = originY;
+        pyr.tileW = tileW;
+        pyr.tileH = tileH;
+        pyr.cols = cols;
+        pyr.rows = rows;
+        pyr.map = nullptr;
+        pyr.mapSize = 0;
+        setLevels(pyr);
+
+        /* Bucket points by tile with a counting sort */
+        int numTiles = cols * rows;
+        vector<int> tileOf(pts.size());
+        vector<size_t> start(numTiles + 1, 0);
+        for (size_t i = 0; i < pts.size(); i++) {
+                int c = (pts[i].x - originX) / tileW;
+                int r = (pts[i].y - originY) / tileH;
+                assert(pts[i].x >= originX && c < cols);
+                assert(pts[i].y >= originY && r < rows);
+                tileOf[i] = r * cols + c;
+                start[tileOf[i] + 1]++;
+        }
+        for (int t = 0; t < numTiles; t++) {
+                start[t + 1] += start[t];
+        }
+        Points bucketed(pts.size());
+        vector<size_t> fill(start.begin(), start.end() - 1);
+        for (size_t i = 0; i < pts.size(); i++) {
+                bucketed[fill[tileOf[i]]++] = pts[i];
+        }
+
+        /* Level (0, 0): one dnc call per tile */
+        vector<Points> hulls(pyr.levelStart.back());
+        parallelFor(numTiles, [&](int t) {
+                if (start[t] == start[t + 1]) return;
+                Points work(bucketed.begin() + start[t],
+                            bucketed.begin() + start[t + 1]);
+                hulls[t] = dnc(work);
+        });
+
+        /*
+         * Every other level pair: (lx, 0) joins the left and right halves on
+         * level (lx - 1, 0), and (lx, ly) joins the lower and upper halves on
+         * level (lx, ly - 1). Both come before (lx, ly) in this order.
+         */
+        for (int lx = 0; lx < pyr.levelsX; lx++) {
+                for (int ly = (lx == 0) ? 1 : 0; ly < pyr.levelsY; ly++) {
+                        int lc = pyr.levelCols[lx];
+                        parallelFor(lc * pyr.levelRows[ly], [&](int k) {
+                                int c = k % lc, r = k / lc;
+                                int a, b;
+                                Points empty;
+                                Points &out = hulls[nodeIndex(pyr, lx, ly,
+                                                              c, r)];
+                                if (ly == 0) {
+                                        a = nodeIndex(pyr, lx - 1, 0, 2 * c,
+                                                      r);
+                                        b = nodeIndex(pyr, lx - 1, 0,
+                                                      2 * c + 1, r);
+                                        out = mergeHulls(hulls[a],
+                                                b < 0 ? empty : hulls[b]);
+                                } else {
+                                        a = nodeIndex(pyr, lx, ly - 1, c,
+                                                      2 * r);
+                                        b = nodeIndex(pyr, lx, ly - 1, c,
+                                                      2 * r + 1);
+                                        out = mergeAbove(hulls[a],
+                                                b < 0 ? empty : hulls[b]);
+                                }
+                        });
+                }
+        }
+
+        /* Flatten the hulls into one array */
+        pyr.ownOffsets.assign(hulls.size() + 1, 0);
+        for (size_t k = 0; k < hulls.size(); k++) {
+                pyr.ownOffsets[k + 1] = pyr.ownOffsets[k] + hulls[k].size();
+        }
+        pyr.ownPts.reserve(pyr.ownOffsets.back());
+        for (size_t k = 0; k < hulls.size(); k++) {
+                pyr.ownPts.insert(pyr.ownPts.end(), hulls[k].begin(),
+                                  hulls[k].end());
+        }
+
+        setVisualization(wasVisual);
+        return pyr;
+}
+
+/******** queryPyramid ********
+ *
+ * Finds the convex hull of all points in a rectangular range of tiles.
+ *
+ * Parameters:
+ *      const HullPyramid &pyr: The pyramid to query.
+ *      int c0, r0:             The first column and row of the range.
+ *      int c1, r1:             The last column and row of the range
+ *                              (inclusive).
+ * Returns:
+ *      A Points object containing the points of the hull, in the same order
+ *      as dnc. Empty if the range holds no points.
+ * Expects:
+ *      0 <= c0 <= c1 < pyr.cols and 0 <= r0 <= r1 < pyr.rows.
+ * Notes:
+ *      Splits the columns and the rows of the range into O(log) aligned
+ *        blocks each. Each column block is a strip of O(log) nodes stacked
+ *        on top of each other, merged bottom to top; the strips are then
+ *        merged left to right. O(log^2) nodes are merged in all, whatever
+ *        the shape of the range.
+ *      The merges are not drawn; the visualization setting is restored
+ *        before returning.
+ ************************/
+Points queryPyramid(const HullPyramid &pyr, int c0, int r0, int c1, int r1)
+{
+        assert(0 <= c0 && c0 <= c1 && c1 < pyr.cols);
+        assert(0 <= r0 && r0 <= r1 && r1 < pyr.rows);
+
+        vector<int> colLevel, colIndex, rowLevel, rowIndex;
+        splitRange(c0, c1, pyr.levelsX, colLevel, colIndex);
+        splitRange(r0, r1, pyr.levelsY, rowLevel, rowIndex);
+
+        bool wasVisual = setVisualization(false);
+        Points hull;
+        for (size_t i = 0; i < colLevel.size(); i++) {
+                Points strip;
+                for (size_t j = 0; j < rowLevel.size(); j++) {
+                        int node = nodeIndex(pyr, colLevel[i], rowLevel[j],
+                                             colIndex[i], rowIndex[j]);
+                        strip = mergeAbove(strip, nodeHull(pyr, node));
+                }
+                hull = mergeHulls(hull, strip);
+        }
+        setVisualization(wasVisual);
+        return hull;
+}
+
+/******** savePyramid ********
+ *
+ * Writes a pyramid to a file that loadPyramid can map back into memory.
+ *
+ * Parameters:
+ *      const HullPyramid &pyr:         The pyramid to save.
+ *      const string &outputFile:       Filename to write to.
+ * Returns:
+ *      None.
+ * Expects:
+ *      None.
+ * Notes:
+ *      Throws an error if outputFile cannot be written.
+ *      The file uses the native byte order.
+ ************************/
+void savePyramid(const HullPyramid &pyr, const string &outputFile)
+{
+        ofstream outfile(outputFile, ios::binary);
+        if (outfile.fail()) {
+                cerr << "Error: could not open file " << outputFile << ".\n";
+                exit(EXIT_FAILURE);
+        }
+
+        PyramidHeader header;
+        memset(&header, 0, sizeof(header));
+        memcpy(header.magic, MAGIC, sizeof(MAGIC));
+        header.originX = pyr.originX;
+        header.originY = pyr.originY;
+        header.tileW = pyr.tileW;
+        header.tileH = pyr.tileH;
+        header.cols = pyr.cols;
+        header.rows = pyr.rows;
+        header.levelsX = pyr.levelsX;
+        header.levelsY = pyr.levelsY;
+        header.numNodes = pyr.levelStart.back();
+        header.numPts = offsetsOf(pyr)[header.numNodes];
+
+        outfile.write((const char *) &header, sizeof(header));
+        outfile.write((const char *) offsetsOf(pyr),
+                      (header.numNodes + 1) * sizeof(uint64_t));
+        outfile.write((const char *) pointsOf(pyr),
+                      header.numPts * sizeof(my_point));
+
+        if (outfile.fail()) {
+                cerr << "Error: could not write file " << outputFile << ".\n";
+                exit(EXIT_FAILURE);
+        }
+}
+
+/******** loadPyramid ********
+ *
+ * Maps a pyramid written by savePyramid into memory.
+ *
+ * Parameters:
+ *      const string &inputFile:        Filename of a saved pyramid.
+ * Returns:
+ *      A HullPyramid that reads its hulls directly from the mapped file.
+ * Expects:
+ *      inputFile was written by savePyramid on a machine with the same
+ *      byte order.
+ * Notes:
+ *      Throws an error if inputFile fails to open or is not a pyramid,
+ *        including a header that does not match the file or offsets that
+ *        point outside it.
+ *      Release the mapping with freePyramid.
+ ************************/
+HullPyramid loadPyramid(const string &inputFile)
+{
+        int fd = open(inputFile.c_str(), O_RDONLY);
+        struct stat info;
+        if (fd < 0 || fstat(fd, &info) != 0) {
+                cerr << "Error: could not open file " << inputFile << ".\n";
+                exit(EXIT_FAILURE);
+        }
+
+        size_t size = info.st_size;
+        void *map = MAP_FAILED;
+        if (size >= sizeof(PyramidHeader)) {
+                map = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        }
+        close(fd);
+
+        const PyramidHeader *header = (const PyramidHeader *) map;
+        if (map == MAP_FAILED || !validHeader(header, size) ||
+            !validOffsets((const uint64_t *) (header + 1), header->numNodes,
+                          header->numPts)) {
+                if (map != MAP_FAILED) munmap(map, size);
+                cerr << "Error: " << inputFile << " is not a hull pyramid.\n";
+                exit(EXIT_FAILURE);
+        }
+
+        HullPyramid pyr;
+        pyr.originX = header->originX;
+        pyr.originY = header->originY;
+        pyr.tileW = header->tileW;
+        pyr.tileH = header->tileH;
+        pyr.cols = header->cols;
+        pyr.rows = header->rows;
+        pyr.map = map;
+        pyr.mapSize = size;
+        setLevels(pyr);
+
+        return pyr;
+}
+
+/******** freePyramid ********
+ *
+ * Releases the memory or file mapping held by a pyramid.
+ *
+ * Parameters:
+ *      HullPyramid &pyr:       The pyramid to free.
+ * Returns:
+ *      None.
+ * Expects:
+ *      pyr is not used again after this call.
+ * Notes:
+ *      None.
+ ************************/
+void freePyramid(HullPyramid &pyr)
+{
+        if (pyr.map != nullptr) {
+                munmap(pyr.map, pyr.mapSize);
+                pyr.map = nullptr;
+                pyr.mapSize = 0;
+        }
+        pyr.ownOffsets.clear();
+        pyr.ownPts.clear();
+}
+
+/******** validHeader ********
+ *
+ * Checks that a mapped file starts with a pyramid header that matches it.
+ *
+ * Parameters:
+ *      const PyramidHeader *header:    The start of the mapped file.
+ *      size_t size:                    The size of the file in bytes.
+ * Returns:
+ *      True if the header describes a grid that setLevels can lay out and
+ *      a node count and point count that fill the file exactly.
+ * Expects:
+ *      size >= sizeof(PyramidHeader).
+ * Notes:
+ *      Checks the grid before computing any sizes from it, so a bad header
+ *        cannot overflow the size check.
+ ************************/
+static bool validHeader(const PyramidHeader *header, size_t size)
+{
+        if (memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0) return false;
+        if (header->tileW <= 0 || header->tileH <= 0) return false;
+        if (header->cols <= 0 || header->cols > MAX_GRID ||
+            header->rows <= 0 || header->rows > MAX_GRID) {
+                return false;
+        }
+
+        HullPyramid layout;
+        layout.cols = header->cols;
+        layout.rows = header->rows;
+        setLevels(layout);
+        if (layout.levelsX != header->levelsX ||
+            layout.levelsY != header->levelsY ||
+            (uint64_t) layout.levelStart.back() != header->numNodes) {
+                return false;
+        }
+
+        size_t rest = size - sizeof(PyramidHeader);
+        size_t offsetBytes = (header->numNodes + 1) * sizeof(uint64_t);
+        return offsetBytes <= rest &&
+               header->numPts == (rest - offsetBytes) / sizeof(my_point) &&
+               (rest - offsetBytes) % sizeof(my_point) == 0;
+}
+
+/******** validOffsets ********
+ *
+ * Checks that every node's hull lies inside the stored points.
+ *
+ * Parameters:
+ *      const uint64_t *offsets:        The node offset table.
+ *      uint64_t numNodes:              The number of nodes.
+ *      uint64_t numPts:                The number of stored points.
+ * Returns:
+ *      True if the offsets start at 0, never decrease, and end at numPts.
+ * Expects:
+ *      offsets holds numNodes + 1 entries.
+ * Notes:
+ *      None.
+ ************************/
+static bool validOffsets(const uint64_t *offsets, uint64_t numNodes,
+                         uint64_t numPts)
+{
+        if (offsets[0] != 0 || offsets[numNodes] != numPts) return false;
+        for (uint64_t k = 0; k < numNodes; k++) {
+                if (offsets[k + 1] < offsets[k]) return false;
+        }
+        return true;
+}
+
+/******** setLevels ********
+ *
+ * Fills in the size and first node index of every level of a pyramid.
+ *
+ * Parameters:
+ *      HullPyramid &pyr:       A pyramid with cols and rows set.
+ * Returns:
+ *      None.
+ * Expects:
+ *      pyr.cols and pyr.rows are positive.
+ * Notes:
+ *      Each column level halves the columns (rounding up) until one is
+ *        left, and likewise for rows. Every pair of a column level and a
+ *        row level is stored. levelStart holds one extra entry: the total
+ *        node count.
+ ************************/
+static void setLevels(HullPyramid &pyr)
+{
+        pyr.levelCols.assign(1, pyr.cols);
+        while (pyr.levelCols.back() > 1) {
+                pyr.levelCols.push_back((pyr.levelCols.back() + 1) / 2);
+        }
+        pyr.levelRows.assign(1, pyr.rows);
+        while (pyr.levelRows.back() > 1) {
+                pyr.levelRows.push_back((pyr.levelRows.back() + 1) / 2);
+        }
+        pyr.levelsX = pyr.levelCols.size();
+        pyr.levelsY = pyr.levelRows.size();
+
+        pyr.levelStart.assign(1, 0);
+        for (int lx = 0; lx < pyr.levelsX; lx++) {
+                for (int ly = 0; ly < pyr.levelsY; ly++) {
+                        pyr.levelStart.push_back(pyr.levelStart.back() +
+                                                 pyr.levelCols[lx] *
+                                                 pyr.levelRows[ly]);
+                }
+        }
+}
+
+/******** nodeIndex ********
+ *
+ * Finds where a node is stored.
+ *
+ * Parameters:
+ *      const HullPyramid &pyr: The pyramid.
+ *      int lx, ly:             The column level and row level.
+ *      int c, r:               The column and row of the node on its level.
+ * Returns:
+ *      The index of the node, or -1 if (c, r) lies outside the level.
+ * Expects:
+ *      c and r are not negative.
+ * Notes:
+ *      None.
+ ************************/
+static int nodeIndex(const HullPyramid &pyr, int lx, int ly, int c, int r)
+{
+        if (c >= pyr.levelCols[lx] || r >= pyr.levelRows[ly]) {
+                return -1;
+        }
+        return pyr.levelStart[lx * pyr.levelsY + ly] +
+               r * pyr.levelCols[lx] + c;
+}
+
+/******** offsetsOf ********
+ *
+ * Finds the node offset table of a pyramid.
+ *
+ * Parameters:
+ *      const HullPyramid &pyr: The pyramid.
+ * Returns:
+ *      A pointer to levelStart.back() + 1 offsets.
+ * Expects:
+ *      None.
+ * Notes:
+ *      Points into the mapped file if the pyramid was loaded.
+ ************************/
+static const uint64_t *offsetsOf(const HullPyramid &pyr)
+{
+        if (pyr.map != nullptr) {
+                return (const uint64_t *) ((const char *) pyr.map +
+                                           sizeof(PyramidHeader));
+        }
+        return pyr.ownOffsets.data();
+}
+
+/******** pointsOf ********
+ *
+ * Finds the stored hull points of a pyramid.
+ *
+ * Parameters:
+ *      const HullPyramid &pyr: The pyramid.
+ * Returns:
+ *      A pointer to the first hull point of node 0.
+ * Expects:
+ *      None.
+ * Notes:
+ *      Points into the mapped file if the pyramid was loaded.
+ ************************/
+static const my_point *pointsOf(const HullPyramid &pyr)
+{
+        if (pyr.map != nullptr) {
+                return (const my_point *) (offsetsOf(pyr) +
+                                           pyr.levelStart.back() + 1);
+        }
+        return pyr.ownPts.data();
+}
+
+/******** nodeHull ********
+ *
+ * Copies the stored hull of a node out of the pyramid.
+ *
+ * Parameters:
+ *      const HullPyramid &pyr: The pyramid.
+ *      int node:               The index of the node.
+ * Returns:
+ *      A Points object containing the node's hull.
+ * Expects:
+ *      node is a valid node index.
+ * Notes:
+ *      None.
+ ************************/
+static Points nodeHull(const HullPyramid &pyr, int node)
+{
+        const uint64_t *offsets = offsetsOf(pyr);
+        const my_point *pts = pointsOf(pyr);
+        return Points(pts + offsets[node], pts + offsets[node + 1]);
+}
+
+/******** mergeAbove ********
+ *
+ * Merges two convex hulls that are separated by a horizontal line.
+ *
+ * Parameters:
+ *      const Points &bottom:   The lower hull.
+ *      const Points &top:      The upper hull.
+ * Returns:
+ *      A Points object containing the points of the merged hull.
+ * Expects:
+ *      Every point of bottom has a smaller y-coordinate than every point of
+ *      top.
+ * Notes:
+ *      Rotates both hulls a quarter turn clockwise so that bottom becomes
+ *        the left hull, merges them with mergeHulls, and rotates back.
+ *        Rotation keeps the hulls' orientation.
+ ************************/
+static Points mergeAbove(const Points &bottom, const Points &top)
+{
+        if (bottom.empty()) return top;
+        if (top.empty()) return bottom;
+
+        return rotate(mergeHulls(rotate(bottom, true), rotate(top, true)),
+                      false);
+}
+
+/******** rotate ********
+ *
+ * Rotates a hull a quarter turn about the origin.
+ *
+ * Parameters:
+ *      const Points &hull:     The hull to rotate.
+ *      bool clockwise:         True maps (x, y) to (y, -x); false maps
+ *                              (x, y) to (-y, x).
+ * Returns:
+ *      The rotated copy of hull, with IDs kept.
+ * Expects:
+ *      None.
+ * Notes:
+ *      None.
+ ************************/
+static Points rotate(const Points &hull, bool clockwise)
+{
+        Points out(hull.size());
+        for (size_t i = 0; i < hull.size(); i++) {
+                out[i].x = clockwise ? hull[i].y : -hull[i].y;
+                out[i].y = clockwise ? -hull[i].x : hull[i].x;
+                out[i].ID = hull[i].ID;
+        }
+        return out;
+}
+
+/******** splitRange ********
+ *
+ * Splits a range of columns or rows into the fewest aligned blocks.
+ *
+ * Parameters:
+ *      int lo, hi:             The inclusive range.
+ *      int levels:             The number of levels on this axis.
+ *      vector<int> &level:     Filled with the level of each block.
+ *      vector<int> &index:     Filled with the index of each block on its
+ *                              level.
+ * Returns:
+ *      None.
+ * Expects:
+ *      0 <= lo <= hi and hi is inside the grid.
+ * Notes:
+ *      Block k on level l covers [k * 2^l, (k + 1) * 2^l). Blocks come out
+ *        in increasing order, at most two per level.
+ ************************/
+static void splitRange(int lo, int hi, int levels, vector<int> &level,
+                       vector<int> &index)
+{
+        while (lo <= hi) {
+                /* Grow the block at lo while it stays aligned and inside */
+                int l = 0;
+                while (l + 1 < levels && lo % (2 << l) == 0 &&
+                       lo + (2 << l) - 1 <= hi) {
+                        l++;
+                }
+                level.push_back(l);
+                index.push_back(lo >> l);
+                lo += 1 << l;
+        }
+}
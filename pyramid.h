@@ -0,0 +1,60 @@
+/*
+ *      pyramid.h
+ *      Justin Paik (jpaik03)
+ *      11 December, 2025
+ *      Divide & Conquer Convex Hull Algorithm
+ *
+ *      Contains the data structure and function declarations for a hull
+ *      pyramid: precomputed convex hulls of every aligned block of map
+ *      tiles.
+ */
+
+#ifndef PYRAMID_H
+#define PYRAMID_H
+
+#include <vector>
+#include <string>
+#include <cstdint>
+
+#include "dnc.h"
+
+using namespace std;
+
+/*
+ * Node (lx, ly, c, r) holds the hull of the 2^lx by 2^ly block of tiles
+ * whose bottom-left tile is (c * 2^lx, r * 2^ly), clipped to the grid.
+ * Level (0, 0) holds one hull per tile. Node hulls are stored back to back;
+ * the hull of node k is points [offsets[k], offsets[k + 1]).
+ */
+struct HullPyramid {
+        int originX, originY;   /* Bottom-left corner of tile (0, 0) */
+        int tileW, tileH;       /* Size of one tile */
+        int cols, rows;         /* Number of tiles */
+        int levelsX, levelsY;   /* Number of column and row levels */
+
+        /* Nodes per column level and row level, and where each level pair
+           (lx, ly) starts: levelStart[lx * levelsY + ly] */
+        vector<int> levelCols, levelRows, levelStart;
+
+        /* Storage when built in memory */
+        vector<uint64_t> ownOffsets;
+        Points ownPts;
+
+        /* Storage when loaded with loadPyramid. Copies share the mapping,
+           so call freePyramid on only one of them. */
+        void *map;
+        size_t mapSize;
+};
+
+/* Most tiles on either side of the grid */
+const int MAX_GRID = 1 << 14;
+
+/* Function Declarations */
+HullPyramid buildPyramid(const Points &pts, int originX, int originY,
+                         int tileW, int tileH, int cols, int rows);
+Points queryPyramid(const HullPyramid &pyr, int c0, int r0, int c1, int r1);
+void savePyramid(const HullPyramid &pyr, const string &outputFile);
+HullPyramid loadPyramid(const string &inputFile);
+void freePyramid(HullPyramid &pyr);
+
+#endif
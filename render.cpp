@@ -0,0 +1,291 @@
+/*
+ *      render.cpp
+ *      Justin Paik (jpaik03)
+ *      11 December, 2025
+ *      Divide & Conquer Convex Hull Algorithm
+ *
+ *      Contains function definitions for drawing large point sets at screen
+ *      resolution. Points are binned into a grid about the size of the
+ *      window, so drawing costs at most one call per pixel no matter how
+ *      many points there are, and lines erased in WHITE can be repaired by
+ *      redrawing only the cells they crossed.
+ */
+
+/* Standard c++ Includes */
+#include <algorithm>
+#include <cmath>
+#include "assert.h"
+
+#include "render.h"
+
+using namespace std;
+
+/* States of a cell in PointLayer::dirty */
+const char MARKED = 1;
+const char REDRAWN = 2;
+
+/* Helper function declarations */
+static Raster makeRaster(const Points &pts);
+static int cellOf(const my_point &p, const Raster &raster);
+static void redrawCell(PointLayer &layer, int c, int r, int color);
+
+/******** makePointLayer ********
+ *
+ * Keeps one point from every occupied cell of a grid over the points.
+ *
+ * Parameters:
+ *      const Points &pts:      The set of points to be drawn.
+ * Returns:
+ *      A PointLayer holding at most GRID_RES * GRID_RES points of pts, the
+ *      first one found in each occupied cell.
+ * Expects:
+ *      pts is not empty.
+ * Notes:
+ *      Drawing the layer looks the same as drawing pts at screen
+ *        resolution. Build it once and reuse it for every frame.
+ ************************/
+PointLayer makePointLayer(const Points &pts)
+{
+        PointLayer layer;
+        layer.raster = makeRaster(pts);
+        layer.cellPoint.assign(GRID_RES * GRID_RES, -1);
+        layer.dirty.assign(GRID_RES * GRID_RES, 0);
+
+        for (size_t i = 0; i < pts.size(); i++) {
+                int cell = cellOf(pts[i], layer.raster);
+                if (layer.cellPoint[cell] < 0) {
+                        layer.cellPoint[cell] = layer.pts.size();
+                        layer.pts.push_back(pts[i]);
+                }
+        }
+        return layer;
+}
+
+/******** drawPointLayer ********
+ *
+ * Draws every point of a layer.
+ *
+ * Parameters:
+ *      const PointLayer &layer:        The layer to draw.
+ *      int color:                      The color to use.
+ * Returns:
+ *      None.
+ * Expects:
+ *      A window is open.
+ * Notes:
+ *      None.
+ ************************/
+void drawPointLayer(const PointLayer &layer, int color)
+{
+        for (size_t i = 0; i < layer.pts.size(); i++) {
+                en47_draw_point(layer.pts[i].x, layer.pts[i].y, color);
+        }
+}
+
+/******** markErased ********
+ *
+ * Records the cells that a line drawn in WHITE may have erased.
+ *
+ * Parameters:
+ *      PointLayer &layer:              The layer that was drawn.
+ *      const my_point &a, &b:          The ends of the erased line.
+ * Returns:
+ *      None.
+ * Expects:
+ *      None.
+ * Notes:
+ *      Walks the line in half-cell steps and marks each cell it crosses.
+ *        Costs O(length in cells), independent of the number of points.
+ ************************/
+void markErased(PointLayer &layer, const my_point &a, const my_point &b)
+{
+        const Raster &raster = layer.raster;
+        double c0 = (a.x - raster.minX) / raster.cellW;
+        double r0 = (a.y - raster.minY) / raster.cellH;
+        double cols = (b.x - a.x) / raster.cellW;
+        double rows = (b.y - a.y) / raster.cellH;
+        int steps = 2 * (int) ceil(max(fabs(cols), fabs(rows))) + 1;
+
+        for (int s = 0; s <= steps; s++) {
+                int c = c0 + cols * s / steps;
+                int r = r0 + rows * s / steps;
+                c = max(0, min(GRID_RES - 1, c));
+                r = max(0, min(GRID_RES - 1, r));
+
+                int cell = r * GRID_RES + c;
+                if (!layer.dirty[cell]) {
+                        layer.dirty[cell] = MARKED;
+                        layer.damaged.push_back(cell);
+                }
+        }
+}
+
+/******** repairErased ********
+ *
+ * Redraws the points in and around every cell marked since the last repair.
+ *
+ * Parameters:
+ *      PointLayer &layer:      The layer that was drawn.
+ *      int color:              The color the points were drawn in.
+ * Returns:
+ *      None.
+ * Expects:
+ *      A window is open.
+ * Notes:
+ *      Neighbouring cells are redrawn too, since a line or a point's mark is
+ *        wider than a cell. Each cell is redrawn once however many erased
+ *        lines crossed it, so a repair costs at most one call per pixel.
+ ************************/
+void repairErased(PointLayer &layer, int color)
+{
+        for (size_t k = 0; k < layer.damaged.size(); k++) {
+                int c = layer.damaged[k] % GRID_RES;
+                int r = layer.damaged[k] / GRID_RES;
+                for (int dr = -1; dr <= 1; dr++) {
+                        for (int dc = -1; dc <= 1; dc++) {
+                                redrawCell(layer, c + dc, r + dr, color);
+                        }
+                }
+        }
+
+        /* Clear the marks of the cells and their neighbours */
+        for (size_t k = 0; k < layer.damaged.size(); k++) {
+                int c = layer.damaged[k] % GRID_RES;
+                int r = layer.damaged[k] / GRID_RES;
+                for (int dr = -1; dr <= 1; dr++) {
+                        for (int dc = -1; dc <= 1; dc++) {
+                                if (c + dc < 0 || c + dc >= GRID_RES ||
+                                    r + dr < 0 || r + dr >= GRID_RES) {
+                                        continue;
+                                }
+                                layer.dirty[(r + dr) * GRID_RES + c + dc] = 0;
+                        }
+                }
+        }
+        layer.damaged.clear();
+}
+
+/******** decimateHull ********
+ *
+ * Drops hull vertices that land in the same cell as the vertex before them.
+ *
+ * Parameters:
+ *      const Points &hull:     The hull to be drawn.
+ *      const Raster &raster:   The grid of the window.
+ * Returns:
+ *      The hull with at most one vertex per cell along its boundary.
+ * Expects:
+ *      None.
+ * Notes:
+ *      The dropped edges are shorter than a pixel, so the outline looks the
+ *        same while the number of segments stays bounded by the perimeter
+ *        in pixels.
+ ************************/
+Points decimateHull(const Points &hull, const Raster &raster)
+{
+        Points kept;
+        int lastCell = -1;
+
+        for (size_t i = 0; i < hull.size(); i++) {
+                int cell = cellOf(hull[i], raster);
+                if (cell != lastCell) {
+                        kept.push_back(hull[i]);
+                        lastCell = cell;
+                }
+        }
+
+        /* The closing edge may also be shorter than a pixel */
+        if (kept.size() > 1 &&
+            cellOf(kept.back(), raster) == cellOf(kept[0], raster)) {
+                kept.pop_back();
+        }
+        return kept;
+}
+
+/******** makeRaster ********
+ *
+ * Builds the grid mapping for the bounding box of a set of points.
+ *
+ * Parameters:
+ *      const Points &pts:      The set of points to be drawn.
+ * Returns:
+ *      A Raster covering every point of pts.
+ * Expects:
+ *      pts is not empty.
+ * Notes:
+ *      Cells are at least one coordinate unit wide, so small inputs keep
+ *        every distinct point in its own cell.
+ ************************/
+static Raster makeRaster(const Points &pts)
+{
+        assert(!pts.empty());
+
+        int minX = pts[0].x, maxX = pts[0].x;
+        int minY = pts[0].y, maxY = pts[0].y;
+        for (size_t i = 1; i < pts.size(); i++) {
+                minX = min(minX, pts[i].x);
+                maxX = max(maxX, pts[i].x);
+                minY = min(minY, pts[i].y);
+                maxY = max(maxY, pts[i].y);
+        }
+
+        Raster raster;
+        raster.minX = minX;
+        raster.minY = minY;
+        raster.cellW = max(1.0, ((double) maxX - minX + 1) / GRID_RES);
+        raster.cellH = max(1.0, ((double) maxY - minY + 1) / GRID_RES);
+        return raster;
+}
+
+/******** cellOf ********
+ *
+ * Finds the grid cell holding a point.
+ *
+ * Parameters:
+ *      const my_point &p:      The point.
+ *      const Raster &raster:   The grid.
+ * Returns:
+ *      The cell index, row * GRID_RES + column.
+ * Expects:
+ *      None.
+ * Notes:
+ *      Points outside the grid are clamped to its edge.
+ ************************/
+static int cellOf(const my_point &p, const Raster &raster)
+{
+        int c = (p.x - raster.minX) / raster.cellW;
+        int r = (p.y - raster.minY) / raster.cellH;
+        c = max(0, min(GRID_RES - 1, c));
+        r = max(0, min(GRID_RES - 1, r));
+        return r * GRID_RES + c;
+}
+
+/******** redrawCell ********
+ *
+ * Redraws the point in one cell, if there is one and it was not already
+ * redrawn in this repair.
+ *
+ * Parameters:
+ *      PointLayer &layer:      The layer that was drawn.
+ *      int c, r:               The column and row of the cell.
+ *      int color:              The color to use.
+ * Returns:
+ *      None.
+ * Expects:
+ *      None.
+ * Notes:
+ *      Does nothing for cells outside the grid.
+ ************************/
+static void redrawCell(PointLayer &layer, int c, int r, int color)
+{
+        if (c < 0 || c >= GRID_RES || r < 0 || r >= GRID_RES) return;
+
+        int cell = r * GRID_RES + c;
+        if (layer.dirty[cell] == REDRAWN) return;
+        layer.dirty[cell] = REDRAWN;
+
+        int i = layer.cellPoint[cell];
+        if (i >= 0) {
+                en47_draw_point(layer.pts[i].x, layer.pts[i].y, color);
+        }
+}
@@ -0,0 +1,45 @@
+/*
+ *      render.h
+ *      Justin Paik (jpaik03)
+ *      11 December, 2025
+ *      Divide & Conquer Convex Hull Algorithm
+ *
+ *      Contains the data structures and function declarations for drawing
+ *      large point sets at screen resolution.
+ */
+
+#ifndef RENDER_H
+#define RENDER_H
+
+#include <vector>
+
+#include "dnc.h"
+
+using namespace std;
+
+/* Cells per side of the occupancy grid, about one per window pixel */
+const int GRID_RES = 512;
+
+/* Maps coordinates to cells of a GRID_RES x GRID_RES grid */
+struct Raster {
+        int minX, minY;
+        double cellW, cellH;
+};
+
+/* One input point per occupied cell, and the cells erased since a repair */
+struct PointLayer {
+        Raster raster;
+        Points pts;
+        vector<int> cellPoint;  /* Index into pts, or -1 if empty */
+        vector<char> dirty;     /* Per cell: marked, redrawn, or 0 */
+        vector<int> damaged;    /* Cells to redraw at the next repair */
+};
+
+/* Function Declarations */
+PointLayer makePointLayer(const Points &pts);
+void drawPointLayer(const PointLayer &layer, int color);
+void markErased(PointLayer &layer, const my_point &a, const my_point &b);
+void repairErased(PointLayer &layer, int color);
+Points decimateHull(const Points &hull, const Raster &raster);
+
+#endif